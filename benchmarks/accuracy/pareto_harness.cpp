@@ -0,0 +1,221 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "integrators/adams_bashforth_moulton.h"
+#include "integrators/symplectic.h"
+#include "maneuvers/hohmann_transfer.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "spacecraft/spacecraft.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::maneuvers;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+// Accuracy versus cost of the steppers and tolerances on reference
+// scenarios.  Every configuration is compared with a tight tolerance dopri5
+// run of the same scenario, rows on the Pareto front of final position error
+// versus RHS evaluations (and versus wall time) are marked.
+//
+//   naomi_pareto [results.csv]
+
+namespace
+{
+/**
+ * Counts the evaluations of the wrapped equations of motion.
+ */
+class counting_eoms final : public equations_of_motion
+{
+  std::shared_ptr<equations_of_motion> m_eoms;
+
+public:
+  mutable std::size_t count = 0;
+
+  explicit counting_eoms(std::shared_ptr<equations_of_motion> eoms): m_eoms(std::move(eoms)){}
+
+  [[nodiscard]] vector_type get_derivative(const vector_type& state, const double t) const override
+  {
+    count++;
+    return m_eoms->get_derivative(state, t);
+  }
+};
+
+struct scenario
+{
+  std::string name;
+  double duration;
+  /// Makes a fresh spacecraft, maneuver plans are used up by a run
+  std::function<std::shared_ptr<spacecraft>()> make_spacecraft;
+};
+
+struct run_result
+{
+  std::string scenario;
+  std::string stepper;
+  std::string setting;
+  double position_error = 0;
+  std::size_t rhs_evaluations = 0;
+  double wall_time = 0;
+  bool front_rhs = false;
+  bool front_time = false;
+};
+
+constexpr int repetitions = 3;
+
+struct run_output
+{
+  arma::vec3 position;
+  std::size_t rhs_evaluations;
+  double wall_time;
+};
+
+/**
+ * Propagates the scenario `repetitions` times, the wall time is the fastest
+ * of them.
+ */
+template <typename Stepper>
+run_output run(const scenario& s, const integrator<Stepper>& integ)
+{
+  const auto eoms = std::make_shared<counting_eoms>(
+      std::make_shared<two_body_force_model_eoms>(std::make_shared<earth>()));
+  run_output output{};
+  output.wall_time = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < repetitions; i++) {
+    const auto sc = s.make_spacecraft();
+    eoms->count = 0;
+    numerical_propagator<Stepper> propagator(integ);
+    propagator.initialize(eoms, {{sc->get_identifier(), sc}});
+
+    const auto start = std::chrono::steady_clock::now();
+    propagator.propagate_to(s.duration);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    output.wall_time = std::min(output.wall_time, elapsed.count());
+    output.rhs_evaluations = eoms->count;
+    output.position = sc->get_pv_coordinates().get_position();
+  }
+  return output;
+}
+
+template <typename Stepper>
+run_result measure(const scenario& s, const arma::vec3& reference, const std::string& stepper,
+                   const std::string& setting, const integrator<Stepper>& integ)
+{
+  const run_output output = run(s, integ);
+  return {s.name, stepper, setting, arma::norm(output.position - reference), output.rhs_evaluations, output.wall_time};
+}
+
+/**
+ * A row is on the front if no other row of its scenario is at least as good
+ * in both error and cost and better in one of them.
+ */
+template <typename Cost>
+void mark_front(std::vector<run_result>& results, const Cost& cost, bool run_result::* flag)
+{
+  for (run_result& r: results) {
+    r.*flag = true;
+    for (const run_result& other: results) {
+      if (other.scenario != r.scenario) continue;
+      const bool no_worse = other.position_error <= r.position_error && cost(other) <= cost(r);
+      const bool better = other.position_error < r.position_error || cost(other) < cost(r);
+      if (no_worse && better) {
+        r.*flag = false;
+        break;
+      }
+    }
+  }
+}
+
+std::vector<run_result> sweep(const scenario& s)
+{
+  fmt::print("{}: computing the reference\n", s.name);
+  const arma::vec3 reference = run(s, integrator(rk_dopri5_stepper(), 1e-13, 1e-13)).position;
+
+  std::vector<run_result> results;
+  for (const double tol: {1e-6, 1e-8, 1e-10, 1e-11}) {
+    const std::string setting = fmt::format("tol={:.0e}", tol);
+    results.push_back(measure(s, reference, "dopri5", setting, integrator(rk_dopri5_stepper(), tol, tol)));
+    results.push_back(measure(s, reference, "abm", setting, integrator(adams_bashforth_moulton_stepper(tol, tol))));
+  }
+  for (const double dt: {60.0, 30.0, 10.0, 5.0}) {
+    const std::string setting = fmt::format("dt={}s", dt);
+    results.push_back(measure(s, reference, "stormer_verlet", setting, integrator(stormer_verlet_stepper(dt))));
+    results.push_back(measure(s, reference, "yoshida4", setting, integrator(yoshida4_stepper(dt))));
+    results.push_back(measure(s, reference, "yoshida6", setting, integrator(yoshida6_stepper(dt))));
+    results.push_back(measure(s, reference, "yoshida8", setting, integrator(yoshida8_stepper(dt))));
+    results.push_back(measure(s, reference, "wisdom_holman", setting, integrator(wisdom_holman_stepper(dt))));
+  }
+  return results;
+}
+}
+
+int main(const int argc, char** argv)
+{
+  constexpr double leo_radius = 6378000 + 250000;
+  constexpr double geo_radius = 42164154.0;
+
+  const std::vector<scenario> scenarios = {
+    {"circular_j2", 60*60*24, []
+     {
+       return std::make_shared<spacecraft>("sc", get_circular_orbit({3900000.0, 3900000.0, 3900000.0}), 100.0);
+     }},
+    {"hohmann_j2", 60*60*32, [=]
+     {
+       const vector_type state = get_circular_orbit({leo_radius, 0, 0});
+       hohmann_transfer ht(state, geo_radius);
+       return std::make_shared<spacecraft>("sc", state, 100.0, ht.get_maneuver_plan());
+     }},
+  };
+
+  std::vector<run_result> results;
+  for (const scenario& s: scenarios) {
+    std::vector<run_result> scenario_results = sweep(s);
+    results.insert(results.end(), scenario_results.begin(), scenario_results.end());
+  }
+  mark_front(results, [](const run_result& r) { return static_cast<double>(r.rhs_evaluations); }, &run_result::front_rhs);
+  mark_front(results, [](const run_result& r) { return r.wall_time; }, &run_result::front_time);
+  std::stable_sort(results.begin(), results.end(), [](const run_result& a, const run_result& b)
+  {
+    return a.scenario != b.scenario ? a.scenario < b.scenario : a.position_error < b.position_error;
+  });
+
+  fmt::print("\n{:<12} {:<15} {:<10} {:>14} {:>10} {:>12}  {}\n",
+             "scenario", "stepper", "setting", "pos error [m]", "rhs evals", "wall [ms]", "pareto (rhs/time)");
+  for (const run_result& r: results) {
+    fmt::print("{:<12} {:<15} {:<10} {:>14.6e} {:>10} {:>12.3f}  {}{}\n",
+               r.scenario, r.stepper, r.setting, r.position_error, r.rhs_evaluations, 1e3 * r.wall_time,
+               r.front_rhs ? "R" : "-", r.front_time ? "T" : "-");
+  }
+
+  if (argc > 1) {
+    std::ofstream out(argv[1]);
+    if (! out) {
+      fmt::print(stderr, "Unable to open {} for writing\n", argv[1]);
+      return 1;
+    }
+    out << "scenario,stepper,setting,position_error,rhs_evaluations,wall_time,pareto_rhs,pareto_time\n";
+    for (const run_result& r: results) {
+      out << fmt::format("{},{},{},{:.9e},{},{:.9e},{},{}\n", r.scenario, r.stepper, r.setting, r.position_error,
+                         r.rhs_evaluations, r.wall_time, r.front_rhs, r.front_time);
+    }
+  }
+  return 0;
+}
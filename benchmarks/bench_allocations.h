@@ -0,0 +1,31 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef BENCH_ALLOCATIONS_H
+#define BENCH_ALLOCATIONS_H
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "profiling/allocation_counter.h"
+
+/**
+ * Reports the heap allocations made since `scope` was created as the
+ * counter `name`, averaged per iteration and divided by `units_per_iteration`
+ * (e.g. 1 for an RHS call, the propagated seconds for a scenario).  Nothing
+ * is reported unless built with NAOMI_COUNT_ALLOCATIONS.
+ */
+inline void report_allocations(benchmark::State& state,
+                               const naomi::profiling::allocation_scope& scope,
+                               const std::string& name,
+                               const double units_per_iteration)
+{
+  if constexpr (naomi::profiling::allocation_counting_enabled) {
+    state.counters[name] = benchmark::Counter(
+        static_cast<double>(scope.get().allocations) / units_per_iteration, benchmark::Counter::kAvgIterations);
+  }
+}
+
+#endif //BENCH_ALLOCATIONS_H
@@ -0,0 +1,42 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <benchmark/benchmark.h>
+
+#include "bodies/earth.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+
+static void BM_EarthPotentialPartialDerivative(benchmark::State& state)
+{
+  earth body;
+  const arma::vec position = {3900000.0, 3900000.0, 3900000.0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(body.get_potential_partial_derivative(position));
+  }
+}
+BENCHMARK(BM_EarthPotentialPartialDerivative);
+
+static void BM_EarthPotentialPartialDerivativeEigen(benchmark::State& state)
+{
+  earth body;
+  const Eigen::Vector3d position = {3900000.0, 3900000.0, 3900000.0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(body.get_potential_partial_derivative(position));
+  }
+}
+BENCHMARK(BM_EarthPotentialPartialDerivativeEigen);
+
+static void BM_CelestialBodyPotentialPartialJit(benchmark::State& state)
+{
+  earth body;
+  arma::vec position = {3900000.0, 3900000.0, 3900000.0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(body.get_potential_partial(position));
+  }
+}
+BENCHMARK(BM_CelestialBodyPotentialPartialJit);
@@ -0,0 +1,45 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <benchmark/benchmark.h>
+
+#include "attitude/torque_free.h"
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "orbits/orbits.h"
+#include "spacecraft/body_shape.h"
+#include "bench_allocations.h"
+
+using namespace naomi;
+using namespace naomi::attitude;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::geometry;
+
+static void BM_TwoBodyDerivative(benchmark::State& state)
+{
+  const two_body_force_model_eoms eoms(std::make_shared<earth>());
+  vector_type x(9, arma::fill::zeros);
+  x.subvec(0, 5) = orbits::get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  const naomi::profiling::allocation_scope allocations;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(eoms.get_derivative(x, 0.0));
+  }
+  report_allocations(state, allocations, "allocs_per_rhs", 1.0);
+}
+BENCHMARK(BM_TwoBodyDerivative);
+
+static void BM_TorqueFreeDerivative(benchmark::State& state)
+{
+  const torque_free_eoms eoms(body_shape::make_rectangle(1, 2, 3, 100).get_inertia_tensor());
+  const vector_type x = {1, 0, 0, 0, 0.01, -0.02, 0.03};
+  const naomi::profiling::allocation_scope allocations;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(eoms.get_derivative(x, 0.0));
+  }
+  report_allocations(state, allocations, "allocs_per_rhs", 1.0);
+}
+BENCHMARK(BM_TorqueFreeDerivative);
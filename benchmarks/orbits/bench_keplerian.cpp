@@ -0,0 +1,101 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <benchmark/benchmark.h>
+
+#include "orbits/cartesian.h"
+#include "orbits/kepler_solver.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbit_batch.h"
+
+using namespace naomi;
+using namespace naomi::orbits;
+
+static void BM_KeplerianToCartesian(benchmark::State& state)
+{
+  const keplerian_orbit orbit(7000000.0, 0.01, 0.9, 0.3, 0.2, 1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(orbit.to_cartesian());
+  }
+}
+BENCHMARK(BM_KeplerianToCartesian);
+
+static void BM_KeplerianFromCartesian(benchmark::State& state)
+{
+  const arma::vec6 pv = keplerian_orbit(7000000.0, 0.01, 0.9, 0.3, 0.2, 1.0).to_cartesian();
+  cartesian_orbit cart(pv.subvec(0, 2), pv.subvec(3, 5));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(keplerian_orbit::from_cartesian(cart));
+  }
+}
+BENCHMARK(BM_KeplerianFromCartesian);
+
+static void BM_BatchKeplerElliptic(benchmark::State& state)
+{
+  const auto n = static_cast<arma::uword>(state.range(0));
+  const arma::vec e = arma::linspace(0.0, 0.95, n);
+  const arma::vec m = arma::linspace(-10.0, 10.0, n);
+  arma::vec eccentric_anomaly(n);
+  for (auto _ : state) {
+    solve_kepler_elliptic(e.memptr(), m.memptr(), eccentric_anomaly.memptr(), n);
+    benchmark::DoNotOptimize(eccentric_anomaly.memptr());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_BatchKeplerElliptic)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_BatchKeplerHyperbolic(benchmark::State& state)
+{
+  const auto n = static_cast<arma::uword>(state.range(0));
+  const arma::vec e = arma::linspace(1.01, 5.0, n);
+  const arma::vec m = arma::linspace(-50.0, 50.0, n);
+  arma::vec hyperbolic_anomaly(n);
+  for (auto _ : state) {
+    solve_kepler_hyperbolic(e.memptr(), m.memptr(), hyperbolic_anomaly.memptr(), n);
+    benchmark::DoNotOptimize(hyperbolic_anomaly.memptr());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_BatchKeplerHyperbolic)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_BatchKeplerianToCartesian(benchmark::State& state)
+{
+  const auto n = static_cast<std::size_t>(state.range(0));
+  keplerian_batch elements(n);
+  for (std::size_t i = 0; i < n; i++) {
+    elements.sma[i] = 7000000.0 + 10.0 * static_cast<double>(i);
+    elements.ecc[i] = 0.01;
+    elements.inc[i] = 0.9;
+    elements.raan[i] = 0.3;
+    elements.aop[i] = 0.2;
+    elements.ma[i] = 1e-3 * static_cast<double>(i);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(keplerian_to_cartesian(elements));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_BatchKeplerianToCartesian)->Arg(1 << 10)->Arg(1 << 20)->UseRealTime();
+
+static void BM_BatchCartesianToKeplerian(benchmark::State& state)
+{
+  const auto n = static_cast<std::size_t>(state.range(0));
+  keplerian_batch elements(n);
+  for (std::size_t i = 0; i < n; i++) {
+    elements.sma[i] = 7000000.0 + 10.0 * static_cast<double>(i);
+    elements.ecc[i] = 0.01;
+    elements.inc[i] = 0.9;
+    elements.raan[i] = 0.3;
+    elements.aop[i] = 0.2;
+    elements.ma[i] = 1e-3 * static_cast<double>(i);
+  }
+  const cartesian_batch states = keplerian_to_cartesian(elements);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cartesian_to_keplerian(states));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_BatchCartesianToKeplerian)->Arg(1 << 10)->Arg(1 << 20)->UseRealTime();
@@ -0,0 +1,85 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <benchmark/benchmark.h>
+
+#include "attitude/torque_free_provider.h"
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "maneuvers/hohmann_transfer.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "simulation/simulation.h"
+#include "spacecraft/spacecraft.h"
+#include "systems/system.h"
+#include "bench_allocations.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::maneuvers;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+// End to end runs of the scenarios in examples/simulation, without their file
+// output
+
+typedef physical_system<numerical_propagator<rk_dopri5_stepper>> system_t;
+
+static void BM_SimpleTwoBodySimulation(benchmark::State& state)
+{
+  const vector_type state_vec = get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  const std::shared_ptr<equations_of_motion> two_body_forces = std::make_shared<two_body_force_model_eoms>(std::make_shared<earth>());
+  const naomi::profiling::allocation_scope allocations;
+  for (auto _ : state) {
+    const auto sc = std::make_shared<spacecraft>("test", state_vec, 100.0);
+    const auto system = std::make_shared<system_t>(sc, two_body_forces);
+    simulation<system_t> sim(system);
+    sim.simulate(60*60*24);
+    benchmark::DoNotOptimize(sc->get_pv_coordinates());
+  }
+  report_allocations(state, allocations, "allocs_per_sim_second", 60*60*24);
+}
+BENCHMARK(BM_SimpleTwoBodySimulation)->Unit(benchmark::kMillisecond);
+
+static void BM_TwoBodySimulationWithAttitude(benchmark::State& state)
+{
+  const vector_type state_vec = get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  const std::shared_ptr<equations_of_motion> two_body_forces = std::make_shared<two_body_force_model_eoms>(std::make_shared<earth>());
+  body_shape geom = body_shape::make_rectangle(1, 1, 1, 100);
+  const naomi::profiling::allocation_scope allocations;
+  for (auto _ : state) {
+    const std::shared_ptr<attitude_provider> torque_free_attitude =
+      std::make_shared<torque_free_attitude_provider>(
+        torque_free_attitude_provider(geom.get_inertia_tensor(), {1, 0, 0, 0}, pv_coordinates(state_vec)));
+    const auto sc = std::make_shared<spacecraft>("test", state_vec, 100.0, torque_free_attitude);
+    const auto system = std::make_shared<system_t>(sc, two_body_forces);
+    simulation<system_t> sim(system);
+    sim.simulate(60*60*24);
+    benchmark::DoNotOptimize(sc->get_pv_coordinates());
+  }
+  report_allocations(state, allocations, "allocs_per_sim_second", 60*60*24);
+}
+BENCHMARK(BM_TwoBodySimulationWithAttitude)->Unit(benchmark::kMillisecond);
+
+static void BM_HohmannTransferSimulation(benchmark::State& state)
+{
+  constexpr double initial_r = 6378000 + 250000;
+  constexpr double target_r = 42164154.0;
+  const vector_type state_vec = get_circular_orbit({initial_r, 0, 0});
+  const std::shared_ptr<equations_of_motion> two_body_forces = std::make_shared<two_body_force_model_eoms>(std::make_shared<earth>());
+  const naomi::profiling::allocation_scope allocations;
+  for (auto _ : state) {
+    hohmann_transfer ht(state_vec, target_r);
+    const auto sc = std::make_shared<spacecraft>("test", state_vec, 100.0, ht.get_maneuver_plan());
+    const auto system = std::make_shared<system_t>(sc, two_body_forces);
+    simulation<system_t> sim(system);
+    sim.simulate(60*60*32);
+    benchmark::DoNotOptimize(sc->get_pv_coordinates());
+  }
+  report_allocations(state, allocations, "allocs_per_sim_second", 60*60*32);
+}
+BENCHMARK(BM_HohmannTransferSimulation)->Unit(benchmark::kMillisecond);
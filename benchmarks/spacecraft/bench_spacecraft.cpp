@@ -0,0 +1,37 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <benchmark/benchmark.h>
+
+#include "attitude/torque_free_provider.h"
+#include "orbits/orbits.h"
+#include "spacecraft/body_shape.h"
+#include "spacecraft/spacecraft.h"
+
+using namespace naomi;
+using namespace naomi::attitude;
+
+static void BM_GetIntegratedState(benchmark::State& state)
+{
+  const vector_type pv = orbits::get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  body_shape geom = body_shape::make_rectangle(1, 1, 1, 100);
+  const std::shared_ptr<attitude_provider> attitude =
+    std::make_shared<torque_free_attitude_provider>(
+      torque_free_attitude_provider(geom.get_inertia_tensor(), {1, 0, 0, 0}, pv_coordinates(pv)));
+  spacecraft sc("sc", pv, 100.0, attitude);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sc.get_state().get_integrated_state());
+  }
+}
+BENCHMARK(BM_GetIntegratedState);
+
+static void BM_BodyShapeRectangle(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(body_shape::make_rectangle(1, 2, 3, 100));
+  }
+}
+BENCHMARK(BM_BodyShapeRectangle);
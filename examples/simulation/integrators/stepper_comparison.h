@@ -0,0 +1,167 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef STEPPER_COMPARISON_H
+#define STEPPER_COMPARISON_H
+
+#include <chrono>
+#include <string>
+
+#include <armadillo>
+
+#include <fmt/core.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "integrators/adams_bashforth_moulton.h"
+#include "integrators/symplectic.h"
+#include "naomi.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+
+using namespace naomi;
+using namespace naomi::orbits;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+
+/**
+ * Integrate `duration` seconds with the given integrator and report the
+ * number of derivative evaluations and the final position error against a
+ * reference state.
+ */
+template <typename Stepper>
+std::pair<std::size_t, double> count_rhs_evaluations(integrator<Stepper> integ,
+                                                     const std::shared_ptr<equations_of_motion>& eoms,
+                                                     const vector_type& initial,
+                                                     const vector_type& reference,
+                                                     const double duration)
+{
+  std::size_t rhs_count = 0;
+  const system_t system = [eoms, &rhs_count](const vector_type& x, vector_type& dxdt, double t)
+  {
+    rhs_count++;
+    dxdt = eoms->get_derivative(x, t);
+  };
+  vector_type state = initial;
+  integ.integrate(system, state, 0.0, duration, 1.0);
+  return {rhs_count, arma::norm(state.subvec(0, 2) - reference.subvec(0, 2))};
+}
+
+/**
+ * Compare the number of derivative evaluations of the Adams-Bashforth-Moulton
+ * stepper and dopri5 over ten LEO orbits for a range of tolerances.
+ */
+inline void adams_bashforth_moulton_rhs_comparison()
+{
+  std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  std::shared_ptr<equations_of_motion> two_body_forces = std::make_shared<two_body_force_model_eoms>(earth_body);
+
+  constexpr double initial_r = 6378000 + 500000;
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({initial_r, 0, 0});
+  const double duration = 10 * keplerian_orbit::get_orbital_period(initial_r);
+
+  const system_t reference_system = [two_body_forces](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = two_body_forces->get_derivative(x, t);
+  };
+  vector_type reference = initial;
+  integrator<rk_dopri5_stepper>(rk_dopri5_stepper(), 1e-13, 1e-13)
+      .integrate(reference_system, reference, 0.0, duration, 1.0);
+
+  fmt::print("{:>10} {:>8} {:>12} {:>16}\n", "tolerance", "stepper", "rhs evals", "position error");
+  for (const double tol : {1e-6, 1e-8, 1e-10, 1e-12}) {
+    const auto [dopri_rhs, dopri_err] = count_rhs_evaluations(
+        integrator<rk_dopri5_stepper>(rk_dopri5_stepper(), tol, tol),
+        two_body_forces, initial, reference, duration);
+    const auto [abm_rhs, abm_err] = count_rhs_evaluations(
+        integrator<adams_bashforth_moulton_stepper<>>(adams_bashforth_moulton_stepper<>(tol, tol)),
+        two_body_forces, initial, reference, duration);
+    fmt::print("{:>10.0e} {:>8} {:>12} {:>16.6e}\n", tol, "dopri5", dopri_rhs, dopri_err);
+    fmt::print("{:>10.0e} {:>8} {:>12} {:>16.6e}\n", tol, "abm", abm_rhs, abm_err);
+  }
+}
+
+/**
+ * Specific orbital energy v^2/2 + U(r) using the compiled potential of the
+ * central body.
+ */
+inline double get_specific_energy(const std::shared_ptr<celestial_body>& body, const vector_type& state)
+{
+  arma::vec pos = state.subvec(0, 2);
+  return 0.5 * arma::dot(state.subvec(3, 5), state.subvec(3, 5)) + body->get_potential(pos);
+}
+
+/**
+ * Propagate `n_orbits` revolutions in chunks of whole orbits and report the
+ * largest relative energy error seen at the chunk boundaries and the wall
+ * time.
+ */
+template <typename Stepper>
+void report_energy_error(const std::string& name,
+                         integrator<Stepper> integ,
+                         const std::shared_ptr<celestial_body>& body,
+                         const vector_type& initial,
+                         const double period,
+                         const std::size_t n_orbits,
+                         const double step_size)
+{
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(body);
+  const system_t system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+
+  const double initial_energy = get_specific_energy(body, initial);
+  const std::size_t chunk = std::max<std::size_t>(1, n_orbits / 100);
+  vector_type state = initial;
+  double max_error = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t orbit = 0; orbit < n_orbits; orbit += chunk) {
+    const double t0 = static_cast<double>(orbit) * period;
+    const double t1 = static_cast<double>(std::min(orbit + chunk, n_orbits)) * period;
+    integ.integrate(system, state, t0, t1, step_size);
+    const double error = std::abs((get_specific_energy(body, state) - initial_energy) / initial_energy);
+    max_error = std::max(max_error, error);
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{:>16} {:>16.6e} {:>12.3f}\n", name, max_error, elapsed.count());
+}
+
+/**
+ * Compare the long term energy error of the symplectic steppers and dopri5
+ * for a J2 perturbed LEO orbit.  The default thousand revolutions keep the
+ * example short, the secular drift of dopri5 shows best over about 1e5.
+ *
+ * @param n_orbits Number of revolutions to propagate
+ * @param dt Fixed step size of the symplectic steppers in seconds
+ */
+inline void symplectic_energy_comparison(const std::size_t n_orbits = 1000, const double dt = 60.0)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+
+  constexpr double initial_r = 6378000 + 500000;
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({initial_r, 0, 0});
+  initial(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(initial.subvec(3, 5));
+  const double period = keplerian_orbit::get_orbital_period(initial_r);
+
+  fmt::print("{:>16} {:>16} {:>12}\n", "stepper", "max |dE/E|", "wall [s]");
+  report_energy_error("stormer-verlet", integrator<stormer_verlet_stepper>(stormer_verlet_stepper(dt)),
+                      earth_body, initial, period, n_orbits, dt);
+  report_energy_error("yoshida4", integrator<yoshida4_stepper>(yoshida4_stepper(dt)),
+                      earth_body, initial, period, n_orbits, dt);
+  report_energy_error("yoshida6", integrator<yoshida6_stepper>(yoshida6_stepper(dt)),
+                      earth_body, initial, period, n_orbits, dt);
+  report_energy_error("yoshida8", integrator<yoshida8_stepper>(yoshida8_stepper(dt)),
+                      earth_body, initial, period, n_orbits, dt);
+  report_energy_error("wisdom-holman", integrator<wisdom_holman_stepper>(wisdom_holman_stepper(dt)),
+                      earth_body, initial, period, n_orbits, dt);
+  report_energy_error("dopri5 1e-10", integrator<rk_dopri5_stepper>(rk_dopri5_stepper(), 1e-10, 1e-10),
+                      earth_body, initial, period, n_orbits, 1.0);
+}
+
+#endif //STEPPER_COMPARISON_H
@@ -0,0 +1,44 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef PARAREAL_EXAMPLE_H
+#define PARAREAL_EXAMPLE_H
+
+#include <armadillo>
+
+#include <fmt/core.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "naomi.h"
+#include "orbits/orbits.h"
+#include "propagators/parareal_propagator.h"
+
+using namespace naomi;
+using namespace naomi::orbits;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+
+/**
+ * Propagate a single LEO spacecraft over one day with Parareal, using the
+ * Kepler/J2 coarse solver, and print the iteration count and speedup.
+ */
+inline void parareal_single_arc()
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> two_body_forces = std::make_shared<two_body_force_model_eoms>(earth_body);
+
+  constexpr double initial_r = 6378000 + 500000;
+  vector_type state = get_circular_orbit({initial_r, 0, 0});
+  state(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(state.subvec(3, 5));
+  const auto sc = std::make_shared<spacecraft>("parareal", state, 100.0);
+
+  parareal_propagator<rk_dopri5_stepper> propagator(sc, two_body_forces, make_kepler_j2_coarse_solver(earth_body));
+  const auto result = propagator.propagate(0.0, 86400.0);
+  fmt::print("parareal: {} slices, {} iterations, {:.2f} s wall, {:.2f} s serial, speedup {:.2f}\n",
+             result.times.size() - 1, result.iterations, result.wall_time, result.serial_time, result.speedup);
+}
+
+#endif //PARAREAL_EXAMPLE_H
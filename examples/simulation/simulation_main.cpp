@@ -2,13 +2,19 @@
 // Created by alex on 7/6/2024.
 //
 
+#include <string_view>
+
+#include "integrators/stepper_comparison.h"
 #include "maneuvers/hohmann_transfer_example.h"
+#include "propagators/parareal_example.h"
 #include "two_body/simple_two_body_propagation.h"
 
 using namespace naomi;
 
-int main(int, char*[])
+int main(int argc, char* argv[])
 {
+  const bool long_energy_comparison = argc > 1 && std::string_view(argv[1]) == "--long-energy-comparison";
+
   // Simple simulation with one object, earth J2 eoms, and file output
   simple_simulation();
 
@@ -28,4 +34,22 @@ int main(int, char*[])
   simple_hohmann_transfer_maneuver_inclined_delayed_start();
 
   bielliptic_hohmann_transfer_maneuver();
+
+  //////////////////////////////////////////////////////
+  ////                 Integrators                  ////
+  //////////////////////////////////////////////////////
+
+  // Derivative evaluations of the multistep stepper against dopri5
+  adams_bashforth_moulton_rhs_comparison();
+
+  // Long term energy error of the symplectic steppers, pass
+  // --long-energy-comparison for the full 1e5 revolutions
+  symplectic_energy_comparison(long_energy_comparison ? 100000 : 1000);
+
+  //////////////////////////////////////////////////////
+  ////                 Propagators                  ////
+  //////////////////////////////////////////////////////
+
+  // Parallel-in-time propagation of a single long arc
+  parareal_single_arc();
 }
@@ -5,6 +5,11 @@
 #ifndef CELESTIAL_BODY_H
 #define CELESTIAL_BODY_H
 
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+
 #include <Eigen/Dense>
 #include <symengine/expression.h>
 #include <armadillo>
@@ -25,9 +30,12 @@ protected:
   SymEngine::RCP<const SymEngine::Basic> m_potential_partial_x;
   SymEngine::RCP<const SymEngine::Basic> m_potential_partial_y;
   SymEngine::RCP<const SymEngine::Basic> m_potential_partial_z;
+  SymEngine::LLVMDoubleVisitor m_potential_visitor;
   SymEngine::LLVMDoubleVisitor m_potential_partial_x_visitor;
   SymEngine::LLVMDoubleVisitor m_potential_partial_y_visitor;
   SymEngine::LLVMDoubleVisitor m_potential_partial_z_visitor;
+  SymEngine::vec_basic m_potential_hessian;
+  SymEngine::LLVMDoubleVisitor m_potential_partial_hessian_visitor;
 
 public:
   virtual ~celestial_body() = default;
@@ -45,29 +53,63 @@ public:
     m_potential_partial_x = m_potential_exp.diff(x);
     m_potential_partial_y = m_potential_exp.diff(y);
     m_potential_partial_z = m_potential_exp.diff(z);
+    m_potential_visitor.init({x, y, z, c}, *m_potential_exp.get_basic());
     m_potential_partial_x_visitor.init({x, y, z, c}, *m_potential_partial_x);
     m_potential_partial_y_visitor.init({x, y, z, c}, *m_potential_partial_y);
     m_potential_partial_z_visitor.init({x, y, z, c}, *m_potential_partial_z);
+
+    // Upper triangle of the Hessian, ordered xx, xy, xz, yy, yz, zz
+    const SymEngine::Expression du_x(m_potential_partial_x);
+    const SymEngine::Expression du_y(m_potential_partial_y);
+    const SymEngine::Expression du_z(m_potential_partial_z);
+    m_potential_hessian = {
+      du_x.diff(x), du_x.diff(y), du_x.diff(z),
+      du_y.diff(y), du_y.diff(z),
+      du_z.diff(z)
+    };
+
+    // The gradient and the Hessian are compiled into a single kernel so that
+    // common subexpressions (powers of r, sin(phi)) are only evaluated once.
+    SymEngine::vec_basic fused_outputs = {
+      m_potential_partial_x, m_potential_partial_y, m_potential_partial_z
+    };
+    fused_outputs.insert(fused_outputs.end(),
+                         m_potential_hessian.begin(),
+                         m_potential_hessian.end());
+    m_potential_partial_hessian_visitor.init({x, y, z, c}, fused_outputs, true);
   }
   virtual SymEngine::Expression get_potential()
   {
     return m_potential_exp;
   }
 
+  /**
+   * The symbolic gradient of the potential with respect to the symbols `x`,
+   * `y` and `z`.
+   *
+   * @return The partial derivatives ordered x, y, z
+   */
+  [[nodiscard]] virtual auto get_potential_partial_expressions() const
+      -> SymEngine::vec_basic
+  {
+    return {m_potential_partial_x, m_potential_partial_y, m_potential_partial_z};
+  }
+
+  /**
+   * Numerical values of the non-positional symbols in the potential.
+   *
+   * @return Map from symbol name to value
+   */
+  [[nodiscard]] virtual auto get_potential_parameters() const
+      -> std::map<std::string, double>
+  {
+    return {{"c", m_mu * m_higher_order_terms[0] * pow(m_eq_radius, 2) / 2}};
+  }
+
   virtual double get_potential(arma::vec& pos)
   {
-    SymEngine::Expression x("x");
-    SymEngine::Expression y("y");
-    SymEngine::Expression z("z");
-    SymEngine::Expression c("c");
-
-    auto v = m_potential_exp.subs({
-        {x, SymEngine::real_double(pos[0])},
-        {y, SymEngine::real_double(pos[1])},
-        {z, SymEngine::real_double(pos[2])},
-        {c, SymEngine::real_double(m_mu * m_higher_order_terms[0] * pow(m_eq_radius, 2) / 2)}
-    });
-    return static_cast<double>(v);
+    double c = m_mu * m_higher_order_terms[0] * pow(m_eq_radius, 2) / 2;
+    return m_potential_visitor.call({pos[0], pos[1], pos[2], c});
   }
 
   virtual arma::vec get_potential_partial(arma::vec& pos)
@@ -82,6 +124,36 @@ public:
     arma::vec result = { du_x, du_y, du_z };
     return result;
   };
+
+  /**
+   * Evaluate the gradient and the Hessian of the potential with one call to
+   * the compiled kernel.
+   *
+   * @param pos Position in the body-centered inertial frame in meters
+   * @return The gradient of the potential and its (symmetric) Hessian
+   */
+  virtual auto get_potential_partial_and_hessian(const arma::vec3& pos)
+      -> std::pair<arma::vec3, arma::mat33>
+  {
+    const double c = m_mu * m_higher_order_terms[0] * pow(m_eq_radius, 2) / 2;
+    const std::array<double, 4> inputs = {pos[0], pos[1], pos[2], c};
+    std::array<double, 9> outputs{};
+    m_potential_partial_hessian_visitor.call(outputs.data(), inputs.data());
+
+    const arma::vec3 partial = {outputs[0], outputs[1], outputs[2]};
+    const arma::mat33 hessian = {
+      {outputs[3], outputs[4], outputs[5]},
+      {outputs[4], outputs[6], outputs[7]},
+      {outputs[5], outputs[7], outputs[8]}
+    };
+    return {partial, hessian};
+  }
+
+  virtual auto get_potential_hessian(const arma::vec3& pos) -> arma::mat33
+  {
+    return get_potential_partial_and_hessian(pos).second;
+  }
+
   virtual Eigen::Vector3d get_potential_partial_derivative(Eigen::Vector3d position) = 0;
   virtual arma::vec get_potential_partial_derivative(arma::vec position) = 0;
 
@@ -0,0 +1,66 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef VARIATIONAL_EQUATIONS_H
+#define VARIATIONAL_EQUATIONS_H
+#include "bodies/celestial_body.h"
+#include "force_model.h"
+
+namespace naomi::forces
+{
+using namespace bodies;
+
+/**
+ * Equations of motion for a position/velocity state augmented with the 6x6
+ * state transition matrix.
+ *
+ * The state is laid out as [r, v, a, vec(Phi)] where `Phi` is stored column
+ * major.  The trajectory is propagated with the central body gravity and the
+ * STM with the variational equations
+ *
+ * $$
+ * \dot{\Phi} = A\Phi, \quad
+ * A = \begin{bmatrix} 0 & I \\\\ -\nabla^2 U & 0 \end{bmatrix}
+ * $$
+ *
+ * where the gradient and Hessian of the potential come from the same compiled
+ * kernel, so the augmented derivative costs one potential evaluation.
+ */
+class variational_eoms final : public equations_of_motion
+{
+  std::shared_ptr<celestial_body> m_central_body;
+
+public:
+  static constexpr std::size_t STM_OFFSET = 9;
+  static constexpr std::size_t STATE_SIZE = STM_OFFSET + 36;
+
+  explicit variational_eoms(const std::shared_ptr<celestial_body>& central_body)
+      : m_central_body(central_body)
+  {
+  }
+
+  ~variational_eoms() override = default;
+
+  [[nodiscard]] vector_type get_derivative(const vector_type& state, double t) const override
+  {
+    const arma::vec3 pos = state.subvec(0, 2);
+    const auto [partial, hessian] =
+        m_central_body->get_potential_partial_and_hessian(pos);
+
+    const arma::mat66 phi =
+        arma::reshape(state.subvec(STM_OFFSET, STATE_SIZE - 1), 6, 6);
+    arma::mat66 phi_dot;
+    phi_dot.rows(0, 2) = phi.rows(3, 5);
+    phi_dot.rows(3, 5) = -hessian * phi.rows(0, 2);
+
+    vector_type dxdt(STATE_SIZE, arma::fill::zeros);
+    dxdt(arma::span(0, 2)) = state.subvec(3, 5);
+    dxdt(arma::span(3, 5)) = -partial;
+    dxdt(arma::span(STM_OFFSET, STATE_SIZE - 1)) = arma::vectorise(phi_dot);
+    return dxdt;
+  }
+};
+}
+
+#endif //VARIATIONAL_EQUATIONS_H
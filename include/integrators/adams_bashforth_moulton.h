@@ -0,0 +1,99 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ADAMS_BASHFORTH_MOULTON_H
+#define ADAMS_BASHFORTH_MOULTON_H
+
+#include <armadillo>
+
+#include "boost/numeric/odeint.hpp"
+#include "integrators/odeint_armadillo.h"
+#include "naomi.h"
+
+namespace naomi::numeric
+{
+
+/**
+ * Variable step, variable order Adams-Bashforth-Moulton predictor-corrector
+ * (PECE, two derivative evaluations per step) that can be used as the
+ * `Stepper` of a `numerical_propagator`.
+ *
+ * Multistep methods carry a history of derivatives, which is only valid as
+ * long as the state evolves smoothly.  The history is discarded whenever the
+ * stepper is handed a state that does not continue its last accepted step,
+ * which covers impulsive maneuvers applied through `apply_control`, and the
+ * propagator also calls `reset()` explicitly after handling an event.
+ *
+ * @tparam MaxOrder The highest order the order adjuster may select
+ */
+template <std::size_t MaxOrder = 8>
+class adams_bashforth_moulton_stepper
+{
+  typedef boost::numeric::odeint::adaptive_adams_bashforth_moulton<
+    MaxOrder,
+    vector_type,
+    double,
+    vector_type,
+    double,
+    boost::numeric::odeint::vector_space_algebra> error_stepper_type;
+  typedef boost::numeric::odeint::controlled_adams_bashforth_moulton<
+    error_stepper_type> controlled_stepper_type;
+  typedef typename controlled_stepper_type::step_adjuster_type step_adjuster_type;
+
+  controlled_stepper_type m_stepper;
+  vector_type m_last_state;
+  double m_last_time = 0.0;
+  bool m_has_history = false;
+
+  [[nodiscard]] bool continues(const vector_type& x, const double t) const
+  {
+    return m_has_history
+        && std::abs(t - m_last_time) <= 1e-9 * std::max(1.0, std::abs(t))
+        && x.n_elem == m_last_state.n_elem
+        && arma::approx_equal(x, m_last_state, "reldiff", 1e-14);
+  }
+
+public:
+  typedef vector_type state_type;
+  typedef vector_type deriv_type;
+  typedef double value_type;
+  typedef double time_type;
+  typedef boost::numeric::odeint::controlled_stepper_tag stepper_category;
+
+  /**
+   * @param abs_tol Absolute error tolerance
+   * @param rel_tol Relative error tolerance
+   * @param max_dt Upper bound of the step size in seconds
+   */
+  explicit adams_bashforth_moulton_stepper(const double abs_tol = 1e-6,
+                                           const double rel_tol = 1e-6,
+                                           const double max_dt = 3600.0)
+      : m_stepper(step_adjuster_type(abs_tol, rel_tol, max_dt))
+  {
+  }
+
+  void reset()
+  {
+    m_stepper.reset();
+    m_has_history = false;
+  }
+
+  template <class System>
+  boost::numeric::odeint::controlled_step_result try_step(System system, vector_type& x, double& t, double& dt)
+  {
+    if (!continues(x, t)) {
+      reset();
+    }
+    const auto result = m_stepper.try_step(system, x, t, dt);
+    if (result == boost::numeric::odeint::success) {
+      m_last_state = x;
+      m_last_time = t;
+      m_has_history = true;
+    }
+    return result;
+  }
+};
+}
+
+#endif //ADAMS_BASHFORTH_MOULTON_H
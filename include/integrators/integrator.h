@@ -5,11 +5,21 @@
 #ifndef INTEGRATOR_H
 #define INTEGRATOR_H
 
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/core.h>
 #include <naomi.h>
 #include <systems/two_body.h>
+#include "boost/numeric/odeint/integrate/max_step_checker.hpp"
+#include "boost/numeric/odeint/stepper/controlled_step_result.hpp"
+#include "boost/numeric/odeint/stepper/stepper_categories.hpp"
 
 #include "propagators/event_detector.h"
+#include "propagators/propagation_stats.h"
 #include "forces/force_model.h"
+#include "integrators/odeint_armadillo.h"
 
 namespace naomi::numeric
 {
@@ -18,16 +28,117 @@ using namespace forces;
 
 typedef std::function<void(const vector_type&, vector_type&, double)> system_t;
 
+/**
+ * Interpolates the state at any time within the last accepted step.
+ */
+typedef std::function<vector_type(double)> step_interpolator_t;
+
+/**
+ * Called by `integrator::integrate_steps` after every accepted step with the
+ * start and end time of the step and an interpolator of the state within it.
+ * Returns the time within the step integration should stop at, or nothing to
+ * continue.
+ */
+typedef std::function<std::optional<double>(double, double, const step_interpolator_t&)> step_handler_t;
+
+/**
+ * Cubic Hermite interpolation of the state within a step from the states and
+ * derivatives at both ends, used for steppers without their own dense output.
+ * The derivatives are only evaluated once a state is actually interpolated.
+ */
+class hermite_interpolator
+{
+  const system_t& m_system;
+  vector_type m_x0;
+  vector_type m_x1;
+  double m_t0;
+  double m_t1;
+  mutable vector_type m_f0;
+  mutable vector_type m_f1;
+  mutable bool m_has_derivatives = false;
+
+public:
+  hermite_interpolator(const system_t& system, vector_type x0, const double t0, vector_type x1, const double t1)
+      : m_system(system), m_x0(std::move(x0)), m_x1(std::move(x1)), m_t0(t0), m_t1(t1)
+  {
+  }
+
+  vector_type operator()(const double t) const
+  {
+    if (t <= m_t0) return m_x0;
+    if (t >= m_t1) return m_x1;
+    if (!m_has_derivatives) {
+      m_f0.set_size(m_x0.n_elem);
+      m_f1.set_size(m_x1.n_elem);
+      m_system(m_x0, m_f0, m_t0);
+      m_system(m_x1, m_f1, m_t1);
+      m_has_derivatives = true;
+    }
+    const double h = m_t1 - m_t0;
+    const double s = (t - m_t0) / h;
+    const double h00 = (1 + 2 * s) * (1 - s) * (1 - s);
+    const double h10 = s * (1 - s) * (1 - s);
+    const double h01 = s * s * (3 - 2 * s);
+    const double h11 = s * s * (s - 1);
+    return h00 * m_x0 + h10 * h * m_f0 + h01 * m_x1 + h11 * h * m_f1;
+  }
+};
+
+/**
+ * Steppers that carry their own error control (e.g. multistep methods) are
+ * driven directly instead of being wrapped with `make_controlled`.
+ */
+template <class Stepper>
+struct is_controlled_stepper
+    : std::is_same<typename Stepper::stepper_category,
+                   boost::numeric::odeint::controlled_stepper_tag>
+{
+};
+
+template <class Stepper, class = void>
+struct has_reset : std::false_type
+{
+};
+
+template <class Stepper>
+struct has_reset<Stepper, std::void_t<decltype(std::declval<Stepper&>().reset())>>
+    : std::true_type
+{
+};
+
+/**
+ * Fixed step steppers (e.g. the symplectic ones) report their step size,
+ * which is used for the first step instead of the caller's guess.
+ */
+template <class Stepper, class = void>
+struct has_step_size : std::false_type
+{
+};
+
+template <class Stepper>
+struct has_step_size<Stepper, std::void_t<decltype(std::declval<const Stepper&>().get_step_size())>>
+    : std::true_type
+{
+};
+
 template< class Stepper>
 class integrator
 {
 public:
   integrator(const integrator& other)
       : m_stepper(other.m_stepper)
+      , m_abs_tol(other.m_abs_tol)
+      , m_rel_tol(other.m_rel_tol)
+      , m_dt(other.m_dt)
+      , m_stats(other.m_stats)
   {
   }
   integrator(integrator&& other) noexcept
       : m_stepper(std::move(other.m_stepper))
+      , m_abs_tol(other.m_abs_tol)
+      , m_rel_tol(other.m_rel_tol)
+      , m_dt(other.m_dt)
+      , m_stats(other.m_stats)
   {
   }
   integrator& operator=(const integrator& other)
@@ -35,6 +146,10 @@ public:
     if (this == &other)
       return *this;
     m_stepper = other.m_stepper;
+    m_abs_tol = other.m_abs_tol;
+    m_rel_tol = other.m_rel_tol;
+    m_dt = other.m_dt;
+    m_stats = other.m_stats;
     return *this;
   }
   integrator& operator=(integrator&& other) noexcept
@@ -42,45 +157,244 @@ public:
     if (this == &other)
       return *this;
     m_stepper = std::move(other.m_stepper);
+    m_abs_tol = other.m_abs_tol;
+    m_rel_tol = other.m_rel_tol;
+    m_dt = other.m_dt;
+    m_stats = other.m_stats;
     return *this;
   }
 
 private:
   Stepper m_stepper;
+  double m_abs_tol = 1.0e-6;
+  double m_rel_tol = 1.0e-6;
+  double m_dt = 0.0;  // last step size suggested by the stepper
+  propagation_stats m_stats;
+
+#if NAOMI_ENABLE_STATS
+  system_t instrument(const system_t& system)
+  {
+    return [this, &system](const vector_type& x, vector_type& dxdt, const double t)
+    {
+      const scoped_stats_timer timer(m_stats.rhs_time);
+      m_stats.rhs_evaluations++;
+      system(x, dxdt, t);
+    };
+  }
+#endif
+
+  /**
+   * The controlled steppers and the step handlers only step forward in time,
+   * a backward interval would otherwise return without integrating.
+   */
+  static void check_forward(const double start_time, const double end_time)
+  {
+    if (end_time < start_time) {
+      throw std::runtime_error(fmt::format(
+          "Can't integrate backward from t = {} to t = {}, only forward intervals are supported", start_time, end_time));
+    }
+  }
+
+  [[nodiscard]] double get_initial_step_size(const double step_size) const
+  {
+    if constexpr (has_step_size<Stepper>::value) {
+      return m_stepper.get_step_size();
+    } else {
+      return step_size;
+    }
+  }
+
+  double integrate_steps_controlled(const system_t& system, vector_type& state, const double start_time, const double end_time, const double step_size, const step_handler_t& on_step)
+  {
+    boost::numeric::odeint::failed_step_checker fail_checker;
+    double dt = m_dt > 0 ? m_dt : get_initial_step_size(step_size);
+    double t = start_time;
+    while (t < end_time) {
+      const bool clipped = t + dt >= end_time;
+      double step = clipped ? end_time - t : dt;
+      vector_type previous = state;
+      const double previous_time = t;
+      NAOMI_STATS(const double step_clock = stats_clock(); const double step_rhs_time = m_stats.rhs_time;)
+      const auto result = m_stepper.try_step(std::cref(system), state, t, step);
+      NAOMI_STATS(m_stats.stepper_time += stats_clock() - step_clock - (m_stats.rhs_time - step_rhs_time);)
+      if (result != boost::numeric::odeint::success) {
+        NAOMI_STATS(m_stats.rejected_steps++;)
+        fail_checker();
+        dt = step;
+        continue;
+      }
+      fail_checker.reset();
+      NAOMI_STATS(m_stats.record_step(t - previous_time);)
+      if (clipped) {
+        // Don't let the last step of an interval shrink the next one
+        t = end_time;
+        dt = std::max(dt, step);
+      } else {
+        dt = step;
+      }
+
+      const hermite_interpolator interpolate(system, previous, previous_time, state, t);
+      if (const auto stop = on_step(previous_time, t, std::cref(interpolate))) {
+        if (*stop < t) {
+          // The interpolant is only good enough to locate the stop, the state
+          // there comes from the stepper
+          state = std::move(previous);
+          t = step_controlled_to(system, state, previous_time, *stop);
+        }
+        break;
+      }
+    }
+    m_dt = dt;
+    return t;
+  }
+
+  /**
+   * Step from `start_time` exactly onto `end_time` within a single accepted
+   * step where possible, shorter steps are taken if the stepper rejects it.
+   */
+  double step_controlled_to(const system_t& system, vector_type& state, const double start_time, const double end_time)
+  {
+    boost::numeric::odeint::failed_step_checker fail_checker;
+    const double time_tol = 1e-12 * std::max(1.0, std::abs(end_time));
+    double t = start_time;
+    double dt = end_time - start_time;
+    while (end_time - t > time_tol) {
+      dt = std::min(dt, end_time - t);
+      const double step_start = t;
+      NAOMI_STATS(const double step_clock = stats_clock(); const double step_rhs_time = m_stats.rhs_time;)
+      const auto result = m_stepper.try_step(std::cref(system), state, t, dt);
+      NAOMI_STATS(m_stats.stepper_time += stats_clock() - step_clock - (m_stats.rhs_time - step_rhs_time);)
+      if (result != boost::numeric::odeint::success) {
+        NAOMI_STATS(m_stats.rejected_steps++;)
+        fail_checker();
+        continue;
+      }
+      fail_checker.reset();
+      NAOMI_STATS(m_stats.record_step(t - step_start);)
+      dt = end_time - t;
+    }
+    return end_time;
+  }
+
+  double integrate_steps_dense(const system_t& system, vector_type& state, const double start_time, const double end_time, const double step_size, const step_handler_t& on_step)
+  {
+    auto stepper = make_dense_output(m_abs_tol, m_rel_tol, m_stepper);
+    double dt = m_dt > 0 ? m_dt : step_size;
+    stepper.initialize(state, start_time, dt);
+    vector_type interpolated(state.n_elem);
+    const step_interpolator_t interpolate = [&stepper, &interpolated](const double t)
+    {
+      stepper.calc_state(t, interpolated);
+      return interpolated;
+    };
+
+    const double time_tol = 1e-12 * std::max(1.0, std::abs(end_time));
+    while (end_time - stepper.current_time() > time_tol) {
+      const bool clipped = stepper.current_time() + stepper.current_time_step() > end_time;
+      if (clipped) {
+        // Land the last step exactly on the end instead of interpolating, and
+        // keep the unclipped step size for the next interval
+        dt = stepper.current_time_step();
+        stepper.initialize(stepper.current_state(), stepper.current_time(), end_time - stepper.current_time());
+      }
+      NAOMI_STATS(const double step_clock = stats_clock(); const double step_rhs_time = m_stats.rhs_time;)
+      const auto [step_start, step_end] = stepper.do_step(std::cref(system));
+      NAOMI_STATS(m_stats.stepper_time += stats_clock() - step_clock - (m_stats.rhs_time - step_rhs_time);)
+      NAOMI_STATS(m_stats.record_step(step_end - step_start);)
+      if (!clipped) {
+        dt = stepper.current_time_step();
+      }
+      if (const auto stop = on_step(step_start, step_end, interpolate)) {
+        state = interpolate(*stop);
+        m_dt = dt;
+        return *stop;
+      }
+    }
+    state = stepper.current_state();
+    m_dt = dt;
+    return end_time;
+  }
 
 public:
   ~ integrator() = default;
   integrator() = default;
+  explicit integrator(Stepper stepper, const double abs_tol = 1.0e-6, const double rel_tol = 1.0e-6)
+      : m_stepper(std::move(stepper)), m_abs_tol(abs_tol), m_rel_tol(rel_tol)
+  {
+  }
 
-  std::pair<double, vector_type> find_event_time(const system_t& system, double start_time, double end_time, std::shared_ptr<event_detector> e, state_and_time_type state, double step_size)
-  {
-    auto stepper = make_dense_output(1.0e-6, 1.0e-6, Stepper());
-    vector_type s = state.first;
-    stepper.initialize(s, start_time, end_time-start_time);
-    stepper.do_step(system);
-    double mid_time;
-    vector_type next_state = s;
-    while(std::abs(end_time - start_time) > 1e-6) {
-      mid_time = 0.5 * (start_time + end_time);  // get the mid point time
-      stepper.calc_state(mid_time, next_state); // obtain the corresponding state
-      state_and_time_type prev = {s, start_time};
-      state_and_time_type curr = {next_state, mid_time};
-      if ((*e)(prev, curr))
-        end_time = mid_time;  // condition changer lies before midpoint
-      else {
-        start_time = mid_time;  // condition changer lies after midpoint
-        s = next_state;
-      }
+  /**
+   * Discard any history carried by the stepper, must be called whenever the
+   * state is changed discontinuously (e.g. by an impulsive maneuver).
+   */
+  void reset()
+  {
+    m_dt = 0.0;
+    if constexpr (has_reset<Stepper>::value) {
+      m_stepper.reset();
+    }
+  }
+
+  /**
+   * @return Counters and timers of this integrator, all zero unless built
+   * with NAOMI_ENABLE_STATS
+   */
+  [[nodiscard]] const propagation_stats& get_stats() const
+  {
+    return m_stats;
+  }
+
+  void reset_stats()
+  {
+    m_stats = {};
+  }
+
+  /**
+   * Integrate from `start_time` to `end_time`, handing every accepted step to
+   * `on_step` which may stop the integration early (e.g. at an event).
+   *
+   * @param system The system to integrate
+   * @param state The initial state, replaced with the state at the returned time
+   * @param start_time The initial time
+   * @param end_time The final time
+   * @param step_size Initial step size guess if no step size is known yet
+   * @param on_step The step handler
+   * @return The time integration stopped at
+   * @throws std::runtime_error If `end_time` is before `start_time`
+   */
+  double integrate_steps(const system_t& system, vector_type& state, double start_time, double end_time, double step_size, const step_handler_t& on_step)
+  {
+    check_forward(start_time, end_time);
+#if NAOMI_ENABLE_STATS
+    const system_t rhs = instrument(system);
+#else
+    const system_t& rhs = system;
+#endif
+    if constexpr (is_controlled_stepper<Stepper>::value) {
+      return integrate_steps_controlled(rhs, state, start_time, end_time, step_size, on_step);
+    } else {
+      return integrate_steps_dense(rhs, state, start_time, end_time, step_size, on_step);
     }
-    // we found the interval of size eps, take it's midpoint as final guess
-    mid_time = 0.5 * (start_time + end_time);
-    stepper.calc_state(mid_time, s);
-    return {mid_time, s};
   }
 
   double integrate(const system_t& system, vector_type& state, double start_time, double end_time, double step_size)
   {
-    integrate_adaptive(make_controlled( 1.0e-6 , 1.0e-6, m_stepper), system, state, start_time, end_time, step_size);
+#if NAOMI_ENABLE_STATS
+    const system_t rhs = instrument(system);
+#else
+    const system_t& rhs = system;
+#endif
+    if constexpr (is_controlled_stepper<Stepper>::value) {
+      check_forward(start_time, end_time);
+      integrate_steps_controlled(rhs, state, start_time, end_time, step_size,
+                                 [](double, double, const step_interpolator_t&) { return std::optional<double>(); });
+    } else {
+      NAOMI_STATS(const double step_clock = stats_clock(); const double step_rhs_time = m_stats.rhs_time;)
+      [[maybe_unused]] const std::size_t steps =
+          integrate_adaptive(make_controlled( m_abs_tol , m_rel_tol, m_stepper), rhs, state, start_time, end_time, step_size);
+      NAOMI_STATS(m_stats.stepper_time += stats_clock() - step_clock - (m_stats.rhs_time - step_rhs_time);)
+      NAOMI_STATS(m_stats.accepted_steps += steps;)
+    }
     // integrate_const(m_stepper, system, state, start_time, end_time, step_size);
     return end_time;
   }
@@ -0,0 +1,54 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ODEINT_ARMADILLO_H
+#define ODEINT_ARMADILLO_H
+
+#include <armadillo>
+#include "boost/numeric/odeint.hpp"
+#include "naomi.h"
+
+using namespace naomi;
+
+template<>
+struct boost::numeric::odeint::vector_space_norm_inf<vector_type>
+{
+  typedef double result_type;
+
+  result_type operator()(const vector_type& s) const
+  {
+    return arma::norm(s, "inf");
+  }
+};  // namespace boost::numeric::odeint
+
+namespace boost::numeric::odeint
+{
+
+template<>
+struct is_resizeable<arma::vec>
+{
+  typedef true_type type;
+  const static bool value = type::value;
+};
+
+template<>
+struct same_size_impl<arma::vec, arma::vec>
+{
+  static bool same_size(const arma::vec& x, const arma::vec& y)
+  {
+    return x.size() == y.size();  // or use .n_elem attributes
+  }
+};
+
+template<>
+struct resize_impl<arma::vec, arma::vec>
+{
+  static void resize(arma::vec& v1, const arma::vec& v2)
+  {
+    v1.resize(v2.size());  // not sure if this is correct for arma
+  }
+};
+}
+
+#endif //ODEINT_ARMADILLO_H
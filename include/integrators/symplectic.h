@@ -0,0 +1,200 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef SYMPLECTIC_H
+#define SYMPLECTIC_H
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "boost/numeric/odeint/stepper/controlled_step_result.hpp"
+#include "boost/numeric/odeint/stepper/stepper_categories.hpp"
+#include "boost/numeric/odeint/util/unwrap_reference.hpp"
+#include "naomi.h"
+#include "constants.h"
+#include "orbits/orbits.h"
+
+namespace naomi::numeric
+{
+
+/**
+ * How the position is advanced between two kicks of a splitting method.
+ */
+enum class symplectic_drift
+{
+  /// Free flight, x += h * v (Stormer-Verlet and its compositions)
+  LINEAR,
+  /// Exact two-body flow about the central body, only the perturbing
+  /// acceleration is applied in the kicks (Wisdom-Holman)
+  KEPLER
+};
+
+/**
+ * Substep weights of the symmetric compositions of the second order
+ * kick-drift-kick map, Yoshida (1990).
+ *
+ * @param order 2, 4, 6 or 8
+ * @return The weights, summing to one
+ */
+inline std::vector<double> get_yoshida_coefficients(const std::size_t order)
+{
+  // Half of a symmetric composition w_k ... w_1 w_0 w_1 ... w_k, w_0 follows
+  // from the weights summing to one
+  auto symmetric = [](const std::vector<double>& w)
+  {
+    double sum = 0;
+    for (const double wi : w) sum += wi;
+    std::vector<double> coefficients(w.rbegin(), w.rend());
+    coefficients.push_back(1 - 2 * sum);
+    coefficients.insert(coefficients.end(), w.begin(), w.end());
+    return coefficients;
+  };
+
+  switch (order) {
+    case 2:
+      return {1.0};
+    case 4:
+      {
+        const double w1 = 1 / (2 - std::cbrt(2.0));
+        return {w1, -std::cbrt(2.0) * w1, w1};
+      }
+    case 6:
+      // Solution A
+      return symmetric({-1.17767998417887, 0.235573213359357, 0.784513610477560});
+    case 8:
+      // Solution D
+      return symmetric({0.102799849391985, -1.96061023297549, 1.93813913762276,
+                        -0.158240635368243, -1.44485223686048, 0.253693336566229,
+                        0.914844246229740});
+    default:
+      throw std::runtime_error(fmt::format("No symplectic composition of order {}", order));
+  }
+}
+
+/**
+ * Fixed step symplectic splitting integrator for the translational state
+ * [r, v, ...] of a `pv_coordinates_provider`, usable as the `Stepper` of a
+ * `numerical_propagator`.
+ *
+ * Each step is a composition of kick-drift-kick maps whose kicks take the
+ * acceleration from the system, so the energy error stays bounded instead of
+ * drifting over long propagations.  The acceleration at the end of a substep
+ * is reused at the start of the next, one step costs `stages + 1` derivative
+ * evaluations.
+ *
+ * The stepper reports itself as controlled so that the integrator drives it
+ * directly; steps longer than the fixed step size are rejected with the fixed
+ * step as suggestion, shorter steps (landing on the end of an interval) are
+ * taken as requested.
+ *
+ * Components after [r, v] are carried along unchanged, a system giving them a
+ * nonzero derivative is rejected with an exception.
+ *
+ * @tparam Order Order of the composition, 2 (Stormer-Verlet), 4, 6 or 8
+ * @tparam Drift Free flight or Kepler drift
+ */
+template <std::size_t Order, symplectic_drift Drift = symplectic_drift::LINEAR>
+class symplectic_stepper
+{
+  std::vector<double> m_coefficients = get_yoshida_coefficients(Order);
+  double m_dt;
+  double m_mu;
+
+  template <class System>
+  arma::vec3 get_kick_acceleration(System& system, const vector_type& x, vector_type& dxdt, const double t) const
+  {
+    system(x, dxdt, t);
+    if (dxdt.n_elem > 6 && arma::any(dxdt.subvec(6, dxdt.n_elem - 1) != 0.0)) {
+      throw std::runtime_error("Symplectic steppers only integrate position and velocity, "
+                               "the state beyond them must have a zero derivative");
+    }
+    arma::vec3 acc = dxdt.subvec(3, 5);
+    if constexpr (Drift == symplectic_drift::KEPLER) {
+      // The Keplerian part is integrated exactly by the drift
+      const arma::vec3 r = x.subvec(0, 2);
+      const double rn = norm(r);
+      acc += m_mu / (rn*rn*rn) * r;
+    }
+    return acc;
+  }
+
+  void drift(vector_type& x, const double h) const
+  {
+    if constexpr (Drift == symplectic_drift::KEPLER) {
+      x.subvec(0, 5) = orbits::kepler_propagate(x.subvec(0, 2), x.subvec(3, 5), h, m_mu);
+    } else {
+      x.subvec(0, 2) += h * x.subvec(3, 5);
+    }
+  }
+
+public:
+  typedef vector_type state_type;
+  typedef vector_type deriv_type;
+  typedef double value_type;
+  typedef double time_type;
+  typedef boost::numeric::odeint::controlled_stepper_tag stepper_category;
+
+  /**
+   * @param dt The fixed step size in seconds
+   * @param mu Gravitational parameter of the central body for the Kepler
+   * drift, unused by the free flight drift
+   */
+  explicit symplectic_stepper(const double dt = 10.0, const double mu = constants::EARTH_MU)
+      : m_dt(dt), m_mu(mu)
+  {
+  }
+
+  [[nodiscard]] double get_step_size() const
+  {
+    return m_dt;
+  }
+
+  [[nodiscard]] std::size_t get_stages() const
+  {
+    return m_coefficients.size();
+  }
+
+  template <class System>
+  boost::numeric::odeint::controlled_step_result try_step(System system, vector_type& x, double& t, double& dt)
+  {
+    if (x.n_elem < 6) {
+      throw std::runtime_error(fmt::format(
+          "Symplectic steppers integrate position and velocity, got a state of size {}", x.n_elem));
+    }
+    if (dt > m_dt * (1 + 1e-12)) {
+      dt = m_dt;
+      return boost::numeric::odeint::fail;
+    }
+    typename boost::numeric::odeint::unwrap_reference<System>::type& sys = system;
+
+    const double h = dt;
+    vector_type dxdt(x.n_elem);
+    double time = t;
+    arma::vec3 acc = get_kick_acceleration(sys, x, dxdt, time);
+    for (const double c : m_coefficients) {
+      x.subvec(3, 5) += 0.5 * c * h * acc;
+      drift(x, c * h);
+      time += c * h;
+      acc = get_kick_acceleration(sys, x, dxdt, time);
+      x.subvec(3, 5) += 0.5 * c * h * acc;
+    }
+
+    t += h;
+    dt = m_dt;
+    return boost::numeric::odeint::success;
+  }
+};
+
+typedef symplectic_stepper<2> stormer_verlet_stepper;
+typedef symplectic_stepper<4> yoshida4_stepper;
+typedef symplectic_stepper<6> yoshida6_stepper;
+typedef symplectic_stepper<8> yoshida8_stepper;
+typedef symplectic_stepper<2, symplectic_drift::KEPLER> wisdom_holman_stepper;
+}
+
+#endif //SYMPLECTIC_H
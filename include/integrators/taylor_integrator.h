@@ -0,0 +1,399 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef TAYLOR_INTEGRATOR_H
+#define TAYLOR_INTEGRATOR_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <symengine/add.h>
+#include <symengine/eval_double.h>
+#include <symengine/expression.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+
+#include "bodies/celestial_body.h"
+#include "naomi.h"
+
+namespace naomi::numeric
+{
+
+enum class taylor_op { VARIABLE, CONSTANT, ADD, MUL, POW };
+
+/**
+ * Elementary operation of a Taylor decomposition.  `lhs` and `rhs` index
+ * earlier nodes of the tape (or the state component for `VARIABLE`), `value`
+ * holds the constant or the exponent of a `POW` node.
+ */
+struct taylor_node
+{
+  taylor_op op;
+  std::size_t lhs = 0;
+  std::size_t rhs = 0;
+  double value = 0.0;
+};
+
+/**
+ * Decomposition of an acceleration expression into a topologically ordered
+ * tape of elementary operations.
+ *
+ * The normalized Taylor coefficients of every node can be computed order by
+ * order with the classic automatic differentiation recurrences (see Jorba and
+ * Zou, "A software package for the numerical integration of ODEs by means of
+ * high-order Taylor methods").  Shared subexpressions of the SymEngine DAG are
+ * only emitted once.
+ */
+class taylor_decomposition
+{
+  std::vector<taylor_node> m_nodes;
+  std::vector<std::size_t> m_outputs;
+  std::map<SymEngine::RCP<const SymEngine::Basic>, std::size_t, SymEngine::RCPBasicKeyLess> m_cache;
+  std::map<std::string, std::size_t> m_variables;
+  std::map<std::string, double> m_parameters;
+
+  std::size_t push(const taylor_node& node)
+  {
+    m_nodes.push_back(node);
+    return m_nodes.size() - 1;
+  }
+
+  std::size_t push_constant(const double value)
+  {
+    return push({taylor_op::CONSTANT, 0, 0, value});
+  }
+
+  /* a^n for a positive integer n, by repeated squaring.  This keeps the
+   * recurrences well defined when a vanishes, e.g. z on an equatorial orbit. */
+  std::size_t push_integer_power(std::size_t base, long n)
+  {
+    std::size_t result = 0;
+    bool has_result = false;
+    while (n > 0) {
+      if (n & 1) {
+        result = has_result ? push({taylor_op::MUL, result, base}) : base;
+        has_result = true;
+      }
+      n >>= 1;
+      if (n > 0) base = push({taylor_op::MUL, base, base});
+    }
+    return result;
+  }
+
+  std::size_t append(const SymEngine::RCP<const SymEngine::Basic>& e)
+  {
+    if (const auto it = m_cache.find(e); it != m_cache.end()) {
+      return it->second;
+    }
+
+    std::size_t idx;
+    if (SymEngine::is_a_Number(*e)) {
+      idx = push_constant(SymEngine::eval_double(*e));
+    } else if (SymEngine::is_a<SymEngine::Symbol>(*e)) {
+      const auto& name = SymEngine::down_cast<const SymEngine::Symbol&>(*e).get_name();
+      if (const auto var = m_variables.find(name); var != m_variables.end()) {
+        idx = push({taylor_op::VARIABLE, var->second});
+      } else if (const auto par = m_parameters.find(name); par != m_parameters.end()) {
+        idx = push_constant(par->second);
+      } else {
+        throw std::runtime_error(
+          fmt::format("Unbound symbol in Taylor decomposition: {}", name));
+      }
+    } else if (SymEngine::is_a<SymEngine::Add>(*e) || SymEngine::is_a<SymEngine::Mul>(*e)) {
+      const auto op = SymEngine::is_a<SymEngine::Add>(*e) ? taylor_op::ADD : taylor_op::MUL;
+      const auto args = e->get_args();
+      idx = append(args[0]);
+      for (std::size_t i = 1; i < args.size(); i++) {
+        idx = push({op, idx, append(args[i])});
+      }
+    } else if (SymEngine::is_a<SymEngine::Pow>(*e)) {
+      const auto& pow_e = SymEngine::down_cast<const SymEngine::Pow&>(*e);
+      const auto base = append(pow_e.get_base());
+      const auto exp = pow_e.get_exp();
+      if (!SymEngine::is_a_Number(*exp)) {
+        throw std::runtime_error(
+          fmt::format("Non-constant exponent in Taylor decomposition: {}", e->__str__()));
+      }
+      if (SymEngine::is_a<SymEngine::Integer>(*exp)
+          && SymEngine::down_cast<const SymEngine::Integer&>(*exp).as_int() > 0) {
+        idx = push_integer_power(
+          base, SymEngine::down_cast<const SymEngine::Integer&>(*exp).as_int());
+      } else {
+        idx = push({taylor_op::POW, base, 0, SymEngine::eval_double(*exp)});
+      }
+    } else {
+      throw std::runtime_error(
+        fmt::format("Unsupported expression in Taylor decomposition: {}", e->__str__()));
+    }
+    m_cache[e] = idx;
+    return idx;
+  }
+
+public:
+  /**
+   * @param outputs The expressions whose Taylor coefficients are needed
+   * @param variables Names of the state symbols, in state order
+   * @param parameters Values of all remaining symbols
+   */
+  taylor_decomposition(const SymEngine::vec_basic& outputs,
+                       const std::vector<std::string>& variables,
+                       std::map<std::string, double> parameters)
+      : m_parameters(std::move(parameters))
+  {
+    for (std::size_t i = 0; i < variables.size(); i++) {
+      m_variables[variables[i]] = i;
+    }
+    for (const auto& output : outputs) {
+      m_outputs.push_back(append(output));
+    }
+    m_cache.clear();
+  }
+
+  taylor_decomposition(std::vector<taylor_node> nodes, std::vector<std::size_t> outputs)
+      : m_nodes(std::move(nodes)), m_outputs(std::move(outputs))
+  {
+  }
+
+  /**
+   * Decompose the acceleration -grad(U) of a celestial body.
+   */
+  static taylor_decomposition from_body(const bodies::celestial_body& body)
+  {
+    SymEngine::vec_basic acceleration;
+    for (const auto& partial : body.get_potential_partial_expressions()) {
+      acceleration.push_back(SymEngine::neg(partial));
+    }
+    return {acceleration, {"x", "y", "z"}, body.get_potential_parameters()};
+  }
+
+  [[nodiscard]] auto get_nodes() const -> const std::vector<taylor_node>&
+  {
+    return m_nodes;
+  }
+
+  [[nodiscard]] auto get_outputs() const -> const std::vector<std::size_t>&
+  {
+    return m_outputs;
+  }
+};
+
+/**
+ * High order Taylor series integrator for the translational dynamics
+ * r'' = -grad(U(r)) of a celestial body.
+ *
+ * The order is picked from the tolerance as in Jorba and Zou (never below
+ * 20), and the step size is chosen a priori from the last two Taylor
+ * coefficients so that no steps are ever rejected.  Every step also provides
+ * a dense output polynomial over the step.
+ */
+class taylor_integrator
+{
+  taylor_decomposition m_decomposition;
+  std::size_t m_order;
+  double m_abs_tol;
+  double m_rel_tol;
+
+  std::vector<double> m_node_coeffs;
+  std::array<std::vector<double>, 6> m_state_coeffs;
+  double m_step_start = 0.0;
+  double m_step_size = 0.0;
+
+  static std::size_t order_from_tolerance(const double tol)
+  {
+    const auto order = static_cast<std::size_t>(std::ceil(-std::log(tol) / 2 + 1));
+    return std::max<std::size_t>(order, 20);
+  }
+
+  double& node_coeff(const std::size_t node, const std::size_t k)
+  {
+    return m_node_coeffs[node * (m_order + 1) + k];
+  }
+
+  void compute_coefficients(const double* x0)
+  {
+    const auto& nodes = m_decomposition.get_nodes();
+    const auto& outputs = m_decomposition.get_outputs();
+    for (std::size_t i = 0; i < 6; i++) {
+      m_state_coeffs[i][0] = x0[i];
+    }
+
+    for (std::size_t k = 0; k < m_order; k++) {
+      for (std::size_t n = 0; n < nodes.size(); n++) {
+        const auto& node = nodes[n];
+        double c = 0.0;
+        switch (node.op) {
+          case taylor_op::VARIABLE:
+            c = m_state_coeffs[node.lhs][k];
+            break;
+          case taylor_op::CONSTANT:
+            c = k == 0 ? node.value : 0.0;
+            break;
+          case taylor_op::ADD:
+            c = node_coeff(node.lhs, k) + node_coeff(node.rhs, k);
+            break;
+          case taylor_op::MUL:
+            for (std::size_t j = 0; j <= k; j++) {
+              c += node_coeff(node.lhs, j) * node_coeff(node.rhs, k - j);
+            }
+            break;
+          case taylor_op::POW: {
+            const double a0 = node_coeff(node.lhs, 0);
+            if (k == 0) {
+              c = std::pow(a0, node.value);
+              break;
+            }
+            for (std::size_t j = 0; j < k; j++) {
+              c += (node.value * static_cast<double>(k - j) - static_cast<double>(j))
+                  * node_coeff(node.lhs, k - j) * node_coeff(n, j);
+            }
+            c /= static_cast<double>(k) * a0;
+            break;
+          }
+        }
+        node_coeff(n, k) = c;
+      }
+
+      const double inv_k1 = 1.0 / static_cast<double>(k + 1);
+      for (std::size_t i = 0; i < 3; i++) {
+        m_state_coeffs[i][k + 1] = m_state_coeffs[i + 3][k] * inv_k1;
+        m_state_coeffs[i + 3][k + 1] = node_coeff(outputs[i], k) * inv_k1;
+      }
+    }
+  }
+
+  [[nodiscard]] double coefficient_norm(const std::size_t k) const
+  {
+    double result = 0.0;
+    for (const auto& coeffs : m_state_coeffs) {
+      result = std::max(result, std::abs(coeffs[k]));
+    }
+    return result;
+  }
+
+  [[nodiscard]] double select_step_size() const
+  {
+    const double eps = m_abs_tol + m_rel_tol * coefficient_norm(0);
+    double rho = std::numeric_limits<double>::infinity();
+    for (const std::size_t k : {m_order - 1, m_order}) {
+      if (const double norm_k = coefficient_norm(k); norm_k > 0.0) {
+        rho = std::min(rho, std::pow(eps / norm_k, 1.0 / static_cast<double>(k)));
+      }
+    }
+    return rho * std::exp(-0.7 / static_cast<double>(m_order - 1));
+  }
+
+  [[nodiscard]] double evaluate(const std::size_t i, const double dt) const
+  {
+    const auto& coeffs = m_state_coeffs[i];
+    double result = coeffs[m_order];
+    for (std::size_t k = m_order; k-- > 0;) {
+      result = result * dt + coeffs[k];
+    }
+    return result;
+  }
+
+public:
+  explicit taylor_integrator(taylor_decomposition decomposition,
+                             const double abs_tol = 1e-15,
+                             const double rel_tol = 1e-15,
+                             const std::size_t order = 0)
+      : m_decomposition(std::move(decomposition))
+      , m_order(order == 0 ? order_from_tolerance(std::max(abs_tol, rel_tol)) : order)
+      , m_abs_tol(abs_tol)
+      , m_rel_tol(rel_tol)
+      , m_node_coeffs(m_decomposition.get_nodes().size() * (m_order + 1))
+  {
+    for (auto& coeffs : m_state_coeffs) {
+      coeffs.resize(m_order + 1);
+    }
+  }
+
+  /**
+   * @param central_body Body providing the symbolic potential
+   * @param abs_tol Absolute tolerance on the position/velocity
+   * @param rel_tol Relative tolerance on the position/velocity
+   * @param order Order of the method, 0 picks it from the tolerances
+   */
+  explicit taylor_integrator(const std::shared_ptr<bodies::celestial_body>& central_body,
+                             const double abs_tol = 1e-15,
+                             const double rel_tol = 1e-15,
+                             const std::size_t order = 0)
+      : taylor_integrator(taylor_decomposition::from_body(*central_body), abs_tol, rel_tol, order)
+  {
+  }
+
+  [[nodiscard]] auto get_order() const -> std::size_t
+  {
+    return m_order;
+  }
+
+  /**
+   * Take a single step of at most `max_dt`.
+   *
+   * @param state Position and velocity (further components are untouched)
+   * @param t Time of `state`, advanced by the step
+   * @param max_dt Upper bound of the step size, its sign sets the direction
+   * @return The size of the step taken
+   * @throws std::runtime_error If the step size is not finite and positive,
+   * e.g. for a non-finite state, which would never advance the time
+   */
+  double do_step(vector_type& state, double& t, const double max_dt)
+  {
+    compute_coefficients(state.memptr());
+    double h = std::min(select_step_size(), std::abs(max_dt));
+    if (! std::isfinite(h) || h <= 0.0) {
+      throw std::runtime_error(fmt::format("Taylor integrator step size {} at t = {} is not finite and positive", h, t));
+    }
+    h = std::copysign(h, max_dt);
+    for (std::size_t i = 0; i < 6; i++) {
+      state[i] = evaluate(i, h);
+    }
+    m_step_start = t;
+    m_step_size = h;
+    t += h;
+    return h;
+  }
+
+  /**
+   * Dense output over the last step taken.
+   *
+   * @param t Time within the last step
+   * @param state Receives the position and velocity at `t`
+   */
+  void calc_state(const double t, vector_type& state) const
+  {
+    for (std::size_t i = 0; i < 6; i++) {
+      state[i] = evaluate(i, t - m_step_start);
+    }
+  }
+
+  /**
+   * Integrate from `start_time` to `end_time`.
+   *
+   * @return The number of steps taken
+   */
+  std::size_t integrate(vector_type& state, double start_time, const double end_time)
+  {
+    std::size_t steps = 0;
+    while (start_time != end_time) {
+      const double remaining = end_time - start_time;
+      if (do_step(state, start_time, remaining) == remaining) {
+        start_time = end_time;
+      }
+      steps++;
+    }
+    return steps;
+  }
+};
+}
+
+#endif //TAYLOR_INTEGRATOR_H
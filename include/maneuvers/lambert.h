@@ -0,0 +1,403 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef LAMBERT_H
+#define LAMBERT_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "constants.h"
+#include "frames/transforms.h"
+#include "maneuver.h"
+#include "maneuver_plan.h"
+
+namespace naomi::maneuvers
+{
+/**
+ * One conic through both positions of a Lambert problem.
+ */
+struct lambert_solution
+{
+  /// Complete revolutions before arrival
+  int revolutions;
+  /// Velocity at the first position on the transfer conic
+  arma::vec3 departure_velocity;
+  /// Velocity at the second position on the transfer conic
+  arma::vec3 arrival_velocity;
+};
+
+namespace detail
+{
+/**
+ * Non-dimensional Lambert problem of Izzo (2015, "Revisiting Lambert's
+ * problem"), the time of flight as a function of the free parameter x for a
+ * given lambda and number of revolutions.
+ */
+class izzo_problem
+{
+  double m_lambda;
+  double m_lambda2;
+  double m_lambda3;
+
+  [[nodiscard]] static double hypergeometric_f(const double z)
+  {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int j = 0; std::abs(term) > 1e-11 && j < 1000; j++) {
+      term *= (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1);
+      sum += term;
+    }
+    return sum;
+  }
+
+  /// Lagrange's form, accurate away from x = 1
+  [[nodiscard]] double lagrange_time(const double x, const int revolutions) const
+  {
+    constexpr double pi = boost::math::double_constants::pi;
+    const double a = 1 / (1 - x * x);
+    if (a > 0) {
+      const double alpha = 2 * std::acos(x);
+      const double beta = std::copysign(2 * std::asin(std::sqrt(m_lambda2 / a)), m_lambda);
+      return a * std::sqrt(a) * ((alpha - std::sin(alpha)) - (beta - std::sin(beta)) + 2 * pi * revolutions) / 2;
+    }
+    const double alpha = 2 * std::acosh(x);
+    const double beta = std::copysign(2 * std::asinh(std::sqrt(-m_lambda2 / a)), m_lambda);
+    return -a * std::sqrt(-a) * ((beta - std::sinh(beta)) - (alpha - std::sinh(alpha))) / 2;
+  }
+
+public:
+  explicit izzo_problem(const double lambda)
+      : m_lambda(lambda), m_lambda2(lambda * lambda), m_lambda3(lambda * lambda * lambda){}
+
+  /**
+   * Non-dimensional time of flight, Battin's series close to x = 1, Lagrange
+   * in between and Lancaster elsewhere.
+   */
+  [[nodiscard]] double time_of_flight(const double x, const int revolutions) const
+  {
+    constexpr double pi = boost::math::double_constants::pi;
+    const double distance = std::abs(x - 1);
+    if (distance > 0.01 && distance < 0.2) {
+      return lagrange_time(x, revolutions);
+    }
+    const double e = x * x - 1;
+    const double rho = std::abs(e);
+    const double z = std::sqrt(1 + m_lambda2 * e);
+    if (distance <= 0.01) {
+      const double eta = z - m_lambda * x;
+      const double q = 4.0 / 3.0 * hypergeometric_f(0.5 * (1 - m_lambda - x * eta));
+      return (eta * eta * eta * q + 4 * m_lambda * eta) / 2 + revolutions * pi / std::pow(rho, 1.5);
+    }
+    const double y = std::sqrt(rho);
+    const double g = x * z - m_lambda * e;
+    const double d = e < 0
+        ? revolutions * pi + std::acos(std::clamp(g, -1.0, 1.0))
+        : std::log(y * (z - m_lambda * x) + g);
+    return (x - m_lambda * z - d / y) / e;
+  }
+
+  /**
+   * First three derivatives of the time of flight `t` at `x`.
+   */
+  [[nodiscard]] arma::vec3 derivatives(const double x, const double t) const
+  {
+    const double one_minus_x2 = 1 - x * x;
+    const double y = std::sqrt(1 - m_lambda2 * one_minus_x2);
+    const double y3 = y * y * y;
+    const double dt = (3 * t * x - 2 + 2 * m_lambda3 * x / y) / one_minus_x2;
+    const double ddt = (3 * t + 5 * x * dt + 2 * (1 - m_lambda2) * m_lambda3 / y3) / one_minus_x2;
+    const double dddt = (7 * x * ddt + 8 * dt - 6 * (1 - m_lambda2) * m_lambda2 * m_lambda3 * x / (y3 * y * y)) / one_minus_x2;
+    return {dt, ddt, dddt};
+  }
+
+  /**
+   * Householder iterations on time_of_flight(x) = t starting from x0.
+   */
+  [[nodiscard]] double solve(const double t, double x, const int revolutions, const double tolerance, const int max_iterations) const
+  {
+    for (int i = 0; i < max_iterations; i++) {
+      const double tof = time_of_flight(x, revolutions);
+      const arma::vec3 d = derivatives(x, tof);
+      const double delta = tof - t;
+      const double d2 = d(0) * d(0);
+      const double next = x - delta * (d2 - delta * d(1) / 2) / (d(0) * (d2 - delta * d(1)) + d(2) * delta * delta / 6);
+      const bool converged = std::abs(next - x) < tolerance;
+      x = next;
+      if (converged) break;
+    }
+    return x;
+  }
+
+  /**
+   * Halley iterations for the minimum time of flight with `revolutions`
+   * complete revolutions.
+   */
+  [[nodiscard]] double minimum_time(const int revolutions, double t_min) const
+  {
+    double x = 0.0;
+    for (int i = 0; i < 12; i++) {
+      const arma::vec3 d = derivatives(x, t_min);
+      if (d(0) == 0.0) break;
+      const double next = x - d(0) * d(1) / (d(1) * d(1) - d(0) * d(2) / 2);
+      const bool converged = std::abs(next - x) < 1e-13;
+      x = next;
+      t_min = time_of_flight(x, revolutions);
+      if (converged) break;
+    }
+    return t_min;
+  }
+
+  [[nodiscard]] double get_lambda() const
+  {
+    return m_lambda;
+  }
+};
+}
+
+/**
+ * Solve Lambert's problem, all conics from `r1` to `r2` in the time of flight
+ * `tof`, with Izzo's algorithm (Izzo 2015, "Revisiting Lambert's problem").
+ *
+ * Every complete number of revolutions up to `max_revolutions` that fits into
+ * the time of flight gives two solutions (the long and the short period
+ * branch), zero revolutions gives one.
+ *
+ * @param r1 Departure position in meters
+ * @param r2 Arrival position in meters
+ * @param tof Time of flight in seconds
+ * @param mu Gravitational parameter of the central body
+ * @param prograde Whether the transfer moves counterclockwise about +z, the
+ * transfer angle is measured in that direction
+ * @param max_revolutions Maximum number of complete revolutions
+ * @return The solutions ordered by the number of revolutions, for
+ * revolutions > 0 the long period branch first
+ */
+inline std::vector<lambert_solution> solve_lambert(const arma::vec3& r1,
+                                                   const arma::vec3& r2,
+                                                   const double tof,
+                                                   const double mu = constants::EARTH_MU,
+                                                   const bool prograde = true,
+                                                   const int max_revolutions = 0)
+{
+  constexpr double pi = boost::math::double_constants::pi;
+  if (tof <= 0) {
+    throw std::runtime_error(fmt::format("Lambert time of flight must be positive, got {}", tof));
+  }
+  const double r1n = arma::norm(r1);
+  const double r2n = arma::norm(r2);
+  const double c = arma::norm(r2 - r1);
+  const double s = (c + r1n + r2n) / 2;
+  const arma::vec3 ir1 = r1 / r1n;
+  const arma::vec3 ir2 = r2 / r2n;
+  const arma::vec3 normal = arma::cross(ir1, ir2);
+  if (arma::norm(normal) < 1e-12) {
+    throw std::runtime_error("Lambert problem with collinear positions has no unique transfer plane");
+  }
+  const arma::vec3 ih = arma::normalise(normal);
+
+  double lambda = std::sqrt(1 - c / s);
+  arma::vec3 it1;
+  arma::vec3 it2;
+  if (ih(2) < 0) {
+    lambda = -lambda;
+    it1 = arma::normalise(arma::cross(ir1, ih));
+    it2 = arma::normalise(arma::cross(ir2, ih));
+  } else {
+    it1 = arma::normalise(arma::cross(ih, ir1));
+    it2 = arma::normalise(arma::cross(ih, ir2));
+  }
+  if (!prograde) {
+    lambda = -lambda;
+    it1 = -it1;
+    it2 = -it2;
+  }
+
+  const detail::izzo_problem problem(lambda);
+  const double lambda2 = lambda * lambda;
+  const double lambda3 = lambda2 * lambda;
+  const double t = std::sqrt(2 * mu / (s * s * s)) * tof;
+
+  // Most revolutions that fit, the minimum time of flight decides the last one
+  int n_max = static_cast<int>(t / pi);
+  const double t00 = std::acos(lambda) + lambda * std::sqrt(1 - lambda2);
+  const double t1 = 2.0 / 3.0 * (1 - lambda3);
+  if (n_max > 0 && t < t00 + n_max * pi && problem.minimum_time(n_max, t00 + n_max * pi) > t) {
+    n_max--;
+  }
+  n_max = std::min(max_revolutions, n_max);
+
+  std::vector<std::pair<int, double>> xs;
+  double x0;
+  if (t >= t00) {
+    x0 = -(t - t00) / (t - t00 + 4);
+  } else if (t <= t1) {
+    x0 = t1 * (t1 - t) / (2.0 / 5.0 * (1 - lambda2 * lambda3) * t) + 1;
+  } else {
+    x0 = std::pow(t / t00, boost::math::double_constants::ln_two / std::log(t1 / t00)) - 1;
+  }
+  xs.emplace_back(0, problem.solve(t, x0, 0, 1e-5, 15));
+  for (int n = 1; n <= n_max; n++) {
+    const double left = std::pow((n * pi + pi) / (8 * t), 2.0 / 3.0);
+    xs.emplace_back(n, problem.solve(t, (left - 1) / (left + 1), n, 1e-8, 15));
+    const double right = std::pow(8 * t / (n * pi), 2.0 / 3.0);
+    xs.emplace_back(n, problem.solve(t, (right - 1) / (right + 1), n, 1e-8, 15));
+  }
+
+  const double gamma = std::sqrt(mu * s / 2);
+  const double rho = (r1n - r2n) / c;
+  const double sigma = std::sqrt(1 - rho * rho);
+  std::vector<lambert_solution> solutions;
+  solutions.reserve(xs.size());
+  for (const auto& [revolutions, x] : xs) {
+    const double y = std::sqrt(1 - lambda2 + lambda2 * x * x);
+    const double vr1 = gamma * ((lambda * y - x) - rho * (lambda * y + x)) / r1n;
+    const double vr2 = -gamma * ((lambda * y - x) + rho * (lambda * y + x)) / r2n;
+    const double vt = gamma * sigma * (y + lambda * x);
+    solutions.push_back({revolutions, vr1 * ir1 + vt / r1n * it1, vr2 * ir2 + vt / r2n * it2});
+  }
+  return solutions;
+}
+
+/**
+ * Two impulse transfer between arbitrary states through the cheapest
+ * solution of Lambert's problem, the general counterpart of
+ * `hohmann_transfer`.
+ */
+class lambert_transfer
+{
+  pv_state_type m_departure_state;
+  pv_state_type m_arrival_state;
+  double m_transit_time;
+  double m_departure_time;
+  lambert_solution m_solution;
+  arma::vec3 m_departure_dv;
+  arma::vec3 m_arrival_dv;
+
+  /**
+   * Impulse at `state` (before the burn) as a maneuver, the direction is
+   * stored in the RIC frame of `state` as `maneuver` expects.
+   */
+  static maneuver make_maneuver(const arma::vec3& dv, const pv_state_type& state, std::shared_ptr<event_detector> trigger)
+  {
+    const double magnitude = arma::norm(dv);
+    const arma::vec3 direction = magnitude > 0
+        ? arma::vec3(eci2ric(state.subvec(0, 2), state.subvec(3, 5)).t() * dv / magnitude)
+        : constants::PLUS_J;
+    return {magnitude, direction, trigger};
+  }
+
+public:
+  /**
+   * @param departure_state Position and velocity before the first burn
+   * @param arrival_state Position and velocity to match with the second burn
+   * @param transit_time Time between both burns in seconds
+   * @param mu Gravitational parameter of the central body
+   * @param max_revolutions Maximum number of complete revolutions on the
+   * transfer conic
+   * @param prograde Whether the transfer moves counterclockwise about +z
+   * @param departure_time Time of the first burn, the default start time of
+   * the maneuver plan
+   */
+  lambert_transfer(pv_state_type departure_state,
+                   pv_state_type arrival_state,
+                   const double transit_time,
+                   const double mu = constants::EARTH_MU,
+                   const int max_revolutions = 0,
+                   const bool prograde = true,
+                   const double departure_time = 0)
+      : m_departure_state(std::move(departure_state))
+      , m_arrival_state(std::move(arrival_state))
+      , m_transit_time(transit_time)
+      , m_departure_time(departure_time)
+  {
+    const auto solutions = solve_lambert(m_departure_state.subvec(0, 2), m_arrival_state.subvec(0, 2),
+                                         m_transit_time, mu, prograde, max_revolutions);
+    double best = std::numeric_limits<double>::infinity();
+    for (const auto& solution : solutions) {
+      const arma::vec3 dv1 = solution.departure_velocity - m_departure_state.subvec(3, 5);
+      const arma::vec3 dv2 = m_arrival_state.subvec(3, 5) - solution.arrival_velocity;
+      if (const double total = arma::norm(dv1) + arma::norm(dv2); total < best) {
+        best = total;
+        m_solution = solution;
+        m_departure_dv = dv1;
+        m_arrival_dv = dv2;
+      }
+    }
+  }
+
+  /**
+   * Generate a maneuver plan with both impulses at fixed times, the first at
+   * the departure time.
+   *
+   * @return Shared pointer to a maneuver plan
+   */
+  [[nodiscard]] auto get_maneuver_plan() const -> std::shared_ptr<maneuver_plan>
+  {
+    return get_maneuver_plan(m_departure_time);
+  }
+
+  /**
+   * Generate a maneuver plan with both impulses at fixed times.
+   *
+   * @param start_time Time of the first burn relative to the beginning of a
+   * simulation, the spacecraft must be in `departure_state` at that time
+   * @return Shared pointer to a maneuver plan
+   */
+  [[nodiscard]] auto get_maneuver_plan(const double start_time) const -> std::shared_ptr<maneuver_plan>
+  {
+    pv_state_type transfer_arrival = m_arrival_state;
+    transfer_arrival.subvec(3, 5) = m_solution.arrival_velocity;
+    const maneuver first = make_maneuver(m_departure_dv, m_departure_state,
+                                         std::make_shared<time_detector>(start_time));
+    const maneuver second = make_maneuver(m_arrival_dv, transfer_arrival,
+                                          std::make_shared<time_detector>(start_time + m_transit_time));
+    return std::make_shared<maneuver_plan>(maneuver_plan({first, second}));
+  }
+
+  /**
+   * @return The departure and arrival impulses in ECI
+   */
+  [[nodiscard]] auto get_delta_vs() const -> std::vector<arma::vec3>
+  {
+    return {m_departure_dv, m_arrival_dv};
+  }
+
+  [[nodiscard]] auto get_dvs() const -> std::vector<double>
+  {
+    return {arma::norm(m_departure_dv), arma::norm(m_arrival_dv)};
+  }
+
+  [[nodiscard]] auto get_total_dv() const -> double
+  {
+    return arma::norm(m_departure_dv) + arma::norm(m_arrival_dv);
+  }
+
+  [[nodiscard]] auto get_transit_time() const -> double
+  {
+    return m_transit_time;
+  }
+
+  [[nodiscard]] auto get_departure_time() const -> double
+  {
+    return m_departure_time;
+  }
+
+  [[nodiscard]] auto get_solution() const -> const lambert_solution&
+  {
+    return m_solution;
+  }
+};
+}
+
+#endif //LAMBERT_H
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "maneuver.h"
+#include "simulation/tracing.h"
 
 namespace naomi
 {
@@ -100,6 +101,12 @@ public:
     return m_maneuvers.at(stage).get_trigger()->g(sv);
   }
 
+  [[nodiscard]] std::optional<double> get_event_time() const override
+  {
+    if (! m_is_active) return std::nullopt;
+    return m_maneuvers.at(stage).get_trigger()->get_event_time();
+  }
+
   vector_type get_control_input(const double dt, spacecraft_state& state)
   {
     vector_type control_inp(9);
@@ -112,6 +119,7 @@ public:
 
   void handle_event(const std::shared_ptr<spacecraft>& sc, double t) override
   {
+    NAOMI_TRACE_SCOPE("maneuver_plan::handle_event", sc->get_identifier());
     _active_maneuvers.push_back(m_maneuvers.at(stage++));
     if (stage >= m_maneuvers.size()) m_is_active = false;
   }
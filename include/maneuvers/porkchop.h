@@ -0,0 +1,208 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef PORKCHOP_H
+#define PORKCHOP_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "constants.h"
+#include "lambert.h"
+#include "orbits/orbit_batch.h"
+#include "orbits/orbits.h"
+
+namespace naomi::maneuvers
+{
+/**
+ * Position and velocity of a body at a time, e.g. a lambda around
+ * `chebyshev_ephemeris::get_state` or `kepler_ephemeris`.
+ */
+using ephemeris_function = std::function<pv_state_type(double)>;
+
+/**
+ * Ephemeris of an unperturbed orbit through `state` at `epoch`.
+ */
+inline ephemeris_function kepler_ephemeris(const pv_state_type& state, const double epoch = 0.0, const double mu = constants::EARTH_MU)
+{
+  return [state, epoch, mu](const double t)
+  {
+    return orbits::kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), t - epoch, mu);
+  };
+}
+
+/**
+ * Grid sweep of Lambert transfers over departure and arrival times, the data
+ * behind a porkchop plot.
+ *
+ * Every cell holds the cheapest transfer (total delta-v of both impulses)
+ * from the departure body at its departure time to the arrival body at its
+ * arrival time.  Both ephemerides are sampled once per grid time, the cells
+ * are then solved independently and split across the hardware threads for
+ * large grids (see `orbits::for_each_chunk`).  Cells without a positive time
+ * of flight or with a degenerate (collinear) geometry are infinite.
+ */
+class porkchop_sweep
+{
+  arma::vec m_departure_times;
+  arma::vec m_arrival_times;
+  arma::mat m_departure_states;
+  arma::mat m_arrival_states;
+  arma::mat m_departure_dv;
+  arma::mat m_arrival_dv;
+  arma::mat m_total_dv;
+  double m_mu;
+  int m_max_revolutions;
+  bool m_prograde;
+
+  static arma::mat sample(const ephemeris_function& ephemeris, const arma::vec& times)
+  {
+    arma::mat states(6, times.n_elem);
+    for (arma::uword i = 0; i < times.n_elem; i++) {
+      states.col(i) = ephemeris(times(i));
+    }
+    return states;
+  }
+
+public:
+  /**
+   * @param departure_ephemeris State of the departure body over time
+   * @param arrival_ephemeris State of the arrival body over time
+   * @param departure_times Departure times, the rows of the result
+   * @param arrival_times Arrival times, the columns of the result
+   * @param mu Gravitational parameter of the central body
+   * @param max_revolutions Maximum number of complete revolutions on the
+   * transfer conics
+   * @param prograde Whether the transfers move counterclockwise about +z
+   */
+  porkchop_sweep(const ephemeris_function& departure_ephemeris,
+                 const ephemeris_function& arrival_ephemeris,
+                 arma::vec departure_times,
+                 arma::vec arrival_times,
+                 const double mu = constants::EARTH_MU,
+                 const int max_revolutions = 0,
+                 const bool prograde = true)
+      : m_departure_times(std::move(departure_times))
+      , m_arrival_times(std::move(arrival_times))
+      , m_mu(mu)
+      , m_max_revolutions(max_revolutions)
+      , m_prograde(prograde)
+  {
+    m_departure_states = sample(departure_ephemeris, m_departure_times);
+    m_arrival_states = sample(arrival_ephemeris, m_arrival_times);
+
+    const arma::uword n_departures = m_departure_times.n_elem;
+    const arma::uword n_arrivals = m_arrival_times.n_elem;
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    m_departure_dv.set_size(n_departures, n_arrivals);
+    m_arrival_dv.set_size(n_departures, n_arrivals);
+    m_total_dv.set_size(n_departures, n_arrivals);
+
+    orbits::for_each_chunk(n_departures * n_arrivals, [&](const std::size_t begin, const std::size_t end)
+    {
+      for (std::size_t cell = begin; cell < end; cell++) {
+        // Column major like the matrices
+        const arma::uword i = cell % n_departures;
+        const arma::uword j = cell / n_departures;
+        double best_departure = infinity;
+        double best_arrival = infinity;
+        const double tof = m_arrival_times(j) - m_departure_times(i);
+        const arma::vec3 r1 = m_departure_states.col(i).subvec(0, 2);
+        const arma::vec3 v1 = m_departure_states.col(i).subvec(3, 5);
+        const arma::vec3 r2 = m_arrival_states.col(j).subvec(0, 2);
+        const arma::vec3 v2 = m_arrival_states.col(j).subvec(3, 5);
+        if (tof > 0 && arma::norm(arma::cross(r1, r2)) >= 1e-12 * arma::norm(r1) * arma::norm(r2)) {
+          for (const auto& solution : solve_lambert(r1, r2, tof, m_mu, m_prograde, m_max_revolutions)) {
+            const double departure = arma::norm(solution.departure_velocity - v1);
+            const double arrival = arma::norm(v2 - solution.arrival_velocity);
+            if (departure + arrival < best_departure + best_arrival) {
+              best_departure = departure;
+              best_arrival = arrival;
+            }
+          }
+        }
+        m_departure_dv(i, j) = best_departure;
+        m_arrival_dv(i, j) = best_arrival;
+        m_total_dv(i, j) = best_departure + best_arrival;
+      }
+    });
+  }
+
+  /**
+   * @return Total delta-v of the cheapest transfer, departures along the rows
+   * and arrivals along the columns
+   */
+  [[nodiscard]] auto get_total_dv() const -> const arma::mat&
+  {
+    return m_total_dv;
+  }
+
+  [[nodiscard]] auto get_departure_dv() const -> const arma::mat&
+  {
+    return m_departure_dv;
+  }
+
+  [[nodiscard]] auto get_arrival_dv() const -> const arma::mat&
+  {
+    return m_arrival_dv;
+  }
+
+  [[nodiscard]] auto get_departure_times() const -> const arma::vec&
+  {
+    return m_departure_times;
+  }
+
+  [[nodiscard]] auto get_arrival_times() const -> const arma::vec&
+  {
+    return m_arrival_times;
+  }
+
+  /**
+   * @return Row (departure) and column (arrival) of the cheapest cell
+   */
+  [[nodiscard]] auto get_best_index() const -> std::pair<arma::uword, arma::uword>
+  {
+    const arma::uvec index = arma::ind2sub(arma::size(m_total_dv), m_total_dv.index_min());
+    return {index(0), index(1)};
+  }
+
+  /**
+   * The transfer of one cell, to build its maneuver plan.  The plan starts at
+   * the departure time of the cell unless given another start time.
+   *
+   * @param departure Row of the cell
+   * @param arrival Column of the cell
+   */
+  [[nodiscard]] auto get_transfer(const arma::uword departure, const arma::uword arrival) const -> lambert_transfer
+  {
+    if (departure >= m_departure_times.n_elem || arrival >= m_arrival_times.n_elem) {
+      throw std::runtime_error(fmt::format("No porkchop cell ({}, {}) in a {}x{} grid",
+          departure, arrival, m_departure_times.n_elem, m_arrival_times.n_elem));
+    }
+    return {
+      pv_state_type(m_departure_states.col(departure)),
+      pv_state_type(m_arrival_states.col(arrival)),
+      m_arrival_times(arrival) - m_departure_times(departure),
+      m_mu,
+      m_max_revolutions,
+      m_prograde,
+      m_departure_times(departure)
+    };
+  }
+
+  [[nodiscard]] auto get_best_transfer() const -> lambert_transfer
+  {
+    const auto [departure, arrival] = get_best_index();
+    return get_transfer(departure, arrival);
+  }
+};
+}
+
+#endif //PORKCHOP_H
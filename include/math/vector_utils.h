@@ -4,6 +4,8 @@
 
 #ifndef VECTOR_UTILS_H
 #define VECTOR_UTILS_H
+#include <cmath>
+
 #include <naomi.h>
 
 namespace naomi::math
@@ -26,5 +28,22 @@ inline arma::mat44 skew(const arma::vec3& x)
       {-x[1], x[0], 0}
   };
 }
+
+/**
+ * Rotation matrix turning vectors by `angle` about `axis` (Rodrigues' formula)
+ *
+ * @param axis Unit vector of the rotation axis
+ * @param angle Rotation angle in radians, positive counterclockwise
+ * @return The active rotation matrix
+ */
+inline arma::mat33 axis_angle_rotation(const arma::vec3& axis, const double angle)
+{
+  const arma::mat33 k = {
+      {0, -axis[2], axis[1]},
+      {axis[2], 0, -axis[0]},
+      {-axis[1], axis[0], 0}
+  };
+  return arma::eye<arma::mat>(3, 3) + std::sin(angle) * k + (1 - std::cos(angle)) * k * k;
+}
 }
 #endif //VECTOR_UTILS_H
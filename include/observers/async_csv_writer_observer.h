@@ -0,0 +1,197 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ASYNC_CSV_WRITER_OBSERVER_H
+#define ASYNC_CSV_WRITER_OBSERVER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "observers/simulation_observer.h"
+#include "observers/spsc_ring_buffer.h"
+
+namespace naomi::observers
+{
+/**
+ * What the simulation thread does when the writer thread falls behind and the
+ * record queue is full.
+ */
+enum class backpressure_policy
+{
+  /// Wait for the writer thread to make room, no record is lost
+  BLOCK,
+  /// Drop the record and count it, propagation never waits on I/O
+  DROP
+};
+
+/**
+ * Fixed size snapshot of one spacecraft, as queued for the writer thread.
+ */
+struct csv_record
+{
+  std::array<char, 32> scid;  // truncated and zero terminated
+  double t;
+  std::array<double, 6> pv;
+  std::array<double, 4> attitude;
+};
+
+/**
+ * CSV writer that keeps formatting and file I/O off the simulation thread.
+ *
+ * `handle_observe_state` only copies each spacecraft into a fixed size record
+ * and pushes it into a single producer single consumer ring.  A background
+ * thread pops the records, formats them with fmt and writes the file in
+ * blocks of `block_size` bytes.  The observer is neither copyable nor
+ * movable, create it with `std::make_shared` directly.
+ *
+ * Columns: t, scid, x, y, z, vx, vy, vz, q0, q1, q2, q3
+ */
+template<class system_t>
+class async_csv_writer_observer: public simulation_observer<system_t>
+{
+  std::string m_filepath;
+  std::ofstream m_fout;
+  spsc_ring_buffer<csv_record> m_queue;
+  backpressure_policy m_policy;
+  std::size_t m_block_size;
+  std::chrono::microseconds m_poll_interval{500};
+  std::atomic<bool> m_stopping = false;
+  std::atomic<std::size_t> m_dropped = 0;
+  std::thread m_writer;
+
+  static void format_record(fmt::memory_buffer& block, const csv_record& r)
+  {
+    fmt::format_to(std::back_inserter(block), "{},{},{},{},{},{},{},{},{},{},{},{}\n",
+                   r.t, r.scid.data(),
+                   r.pv[0], r.pv[1], r.pv[2], r.pv[3], r.pv[4], r.pv[5],
+                   r.attitude[0], r.attitude[1], r.attitude[2], r.attitude[3]);
+  }
+
+  void write_records()
+  {
+    fmt::memory_buffer block;
+    csv_record record{};
+    while (true) {
+      // Read the flag before draining, everything pushed before it was set
+      // is then drained before exiting
+      const bool stopping = m_stopping.load(std::memory_order_acquire);
+      while (m_queue.try_pop(record)) {
+        format_record(block, record);
+        if (block.size() >= m_block_size) {
+          m_fout.write(block.data(), static_cast<std::streamsize>(block.size()));
+          block.clear();
+        }
+      }
+      if (stopping) {
+        break;
+      }
+      std::this_thread::sleep_for(m_poll_interval);
+    }
+    m_fout.write(block.data(), static_cast<std::streamsize>(block.size()));
+    m_fout.close();
+  }
+
+  void push(const csv_record& record)
+  {
+    if (m_policy == backpressure_policy::BLOCK) {
+      while (! m_queue.try_push(record)) {
+        std::this_thread::yield();
+      }
+    } else if (! m_queue.try_push(record)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void stop()
+  {
+    if (m_writer.joinable()) {
+      m_stopping.store(true, std::memory_order_release);
+      m_writer.join();
+    }
+  }
+
+public:
+  /**
+   * @param obs_interval Observation interval in seconds
+   * @param filepath Path of the CSV file, overwritten
+   * @param policy What to do when the record queue is full
+   * @param queue_capacity Number of queued records, a power of two
+   * @param block_size Bytes formatted before each write to the file
+   */
+  async_csv_writer_observer(const double obs_interval,
+                            std::string filepath,
+                            const backpressure_policy policy = backpressure_policy::DROP,
+                            const std::size_t queue_capacity = 1 << 16,
+                            const std::size_t block_size = 1 << 20)
+      : simulation_observer<system_t>(obs_interval)
+      , m_filepath(std::move(filepath))
+      , m_queue(queue_capacity)
+      , m_policy(policy)
+      , m_block_size(block_size)
+  {
+  }
+
+  async_csv_writer_observer(const async_csv_writer_observer&) = delete;
+  async_csv_writer_observer& operator=(const async_csv_writer_observer&) = delete;
+
+  ~async_csv_writer_observer() override
+  {
+    stop();
+  }
+
+  void initialize(const std::shared_ptr<system_t>& system) override
+  {
+    m_fout.open(m_filepath, std::ios::out | std::ios::binary);
+    if (! m_fout) {
+      throw std::runtime_error(fmt::format("Unable to open {} for writing", m_filepath));
+    }
+    m_fout << "t,scid,x,y,z,vx,vy,vz,q0,q1,q2,q3\n";
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_writer = std::thread(&async_csv_writer_observer::write_records, this);
+    this->observe_state(system);
+  }
+
+  void handle_observe_state(const std::shared_ptr<system_t>& system) override
+  {
+    const double t = system->get_current_time();
+    for (const auto& [id, sc]: system->get_spacecrafts()) {
+      csv_record record{};
+      id.copy(record.scid.data(), std::min(id.size(), record.scid.size() - 1));
+      record.t = t;
+      const arma::vec pv = sc->get_pv_coordinates().to_vec();
+      std::copy_n(pv.begin(), record.pv.size(), record.pv.begin());
+      const quaternion_type attitude = sc->get_attitude();
+      std::copy_n(attitude.begin(), record.attitude.size(), record.attitude.begin());
+      push(record);
+    }
+  }
+
+  /**
+   * Waits for the writer thread to write every queued record.
+   */
+  void terminate(const std::shared_ptr<system_t>& system) override
+  {
+    stop();
+  }
+
+  /**
+   * @return The number of records dropped because the queue was full
+   */
+  [[nodiscard]] std::size_t get_dropped_count() const
+  {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+};
+}
+
+#endif //ASYNC_CSV_WRITER_OBSERVER_H
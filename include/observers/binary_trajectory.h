@@ -0,0 +1,392 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef BINARY_TRAJECTORY_H
+#define BINARY_TRAJECTORY_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+
+#ifdef _WIN32
+  // Keep windows.h from defining min/max macros that break std::min/std::max
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace naomi::observers
+{
+/**
+ * Binary columnar trajectory files.
+ *
+ * All values are little-endian and every column starts 8 byte aligned, so a
+ * memory-mapped file can be read in place.
+ *
+ *   header  magic "NAOMITRJ", u32 version, u32 column count,
+ *           per column: char[8] name and u32 element size,
+ *           u32 spacecraft count, per spacecraft: u32 length and the id,
+ *           zero padding to 8 bytes
+ *   chunks  u64 rows, f64 t_min, f64 t_max, the u32 scid column (index into
+ *           the spacecraft ids) zero padded to 8 bytes, then the f64 columns
+ *           t, x, y, z, vx, vy, vz, q0, q1, q2, q3 of `rows` values each
+ *   index   per chunk: u64 offset, u64 rows, f64 t_min, f64 t_max
+ *   trailer u64 chunk count, u64 index offset, magic "NAOMIIDX"
+ *
+ * Rows are written in time order, so the per chunk time ranges of the index
+ * locate any time span without touching the chunks themselves.
+ */
+namespace binary_trajectory
+{
+constexpr std::array<char, 8> file_magic = {'N', 'A', 'O', 'M', 'I', 'T', 'R', 'J'};
+constexpr std::array<char, 8> index_magic = {'N', 'A', 'O', 'M', 'I', 'I', 'D', 'X'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t chunk_header_size = 3 * sizeof(std::uint64_t);
+constexpr std::size_t index_entry_size = 4 * sizeof(std::uint64_t);
+constexpr std::size_t trailer_size = 2 * sizeof(std::uint64_t) + index_magic.size();
+
+/// Names of the f64 columns following the scid column in every chunk
+constexpr std::array<const char*, 11> value_columns = {"t", "x", "y", "z", "vx", "vy", "vz", "q0", "q1", "q2", "q3"};
+
+inline std::size_t padded(const std::size_t size)
+{
+  return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+/**
+ * The format is read and written in place, which needs a little-endian host.
+ */
+inline void check_byte_order()
+{
+  constexpr std::uint16_t probe = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &probe, 1);
+  if (first_byte != 1) {
+    throw std::runtime_error("Binary trajectory files require a little-endian host");
+  }
+}
+}
+
+/**
+ * Columns of `double` values of a binary trajectory.
+ */
+enum class trajectory_column : std::size_t
+{
+  T, X, Y, Z, VX, VY, VZ, Q0, Q1, Q2, Q3
+};
+
+/**
+ * Non-owning view of a contiguous column within a memory-mapped file.
+ */
+template <typename T>
+class column_view
+{
+  const T* m_data = nullptr;
+  std::size_t m_size = 0;
+
+public:
+  column_view() = default;
+  column_view(const T* data, const std::size_t size): m_data(data), m_size(size){}
+
+  [[nodiscard]] const T* data() const { return m_data; }
+  [[nodiscard]] std::size_t size() const { return m_size; }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  [[nodiscard]] const T* begin() const { return m_data; }
+  [[nodiscard]] const T* end() const { return m_data + m_size; }
+  const T& operator[](const std::size_t i) const { return m_data[i]; }
+
+  [[nodiscard]] column_view subview(const std::size_t offset, const std::size_t count) const
+  {
+    return {m_data + offset, count};
+  }
+};
+
+/**
+ * Rows of one chunk of a binary trajectory, or a time range of them.
+ */
+class trajectory_chunk
+{
+  column_view<std::uint32_t> m_scid;
+  std::array<column_view<double>, binary_trajectory::value_columns.size()> m_columns;
+
+public:
+  trajectory_chunk(const std::uint32_t* scid, const double* columns, const std::size_t rows)
+      : m_scid(scid, rows)
+  {
+    for (std::size_t i = 0; i < m_columns.size(); i++) {
+      m_columns[i] = {columns + i * rows, rows};
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return m_scid.size();
+  }
+
+  /**
+   * @return Index of each row's spacecraft in `trajectory_reader::get_spacecraft_ids`
+   */
+  [[nodiscard]] column_view<std::uint32_t> get_scid() const
+  {
+    return m_scid;
+  }
+
+  [[nodiscard]] column_view<double> get_column(const trajectory_column column) const
+  {
+    return m_columns[static_cast<std::size_t>(column)];
+  }
+
+  /**
+   * @return The rows with start_time <= t <= end_time
+   */
+  [[nodiscard]] trajectory_chunk slice(const double start_time, const double end_time) const
+  {
+    const column_view<double> t = get_column(trajectory_column::T);
+    const auto first = static_cast<std::size_t>(std::lower_bound(t.begin(), t.end(), start_time) - t.begin());
+    const auto last = static_cast<std::size_t>(std::upper_bound(t.begin(), t.end(), end_time) - t.begin());
+    trajectory_chunk sliced = *this;
+    const std::size_t count = std::max(first, last) - first;
+    sliced.m_scid = m_scid.subview(first, count);
+    for (auto& column: sliced.m_columns) {
+      column = column.subview(first, count);
+    }
+    return sliced;
+  }
+};
+
+/**
+ * Memory-mapped reader of binary trajectory files.  Only the header and the
+ * chunk index are parsed on opening, columns are views into the mapping and
+ * are paged in by the OS on first access.
+ */
+class trajectory_reader
+{
+  struct index_entry
+  {
+    std::uint64_t offset;
+    std::uint64_t rows;
+    double t_min;
+    double t_max;
+  };
+
+  const unsigned char* m_data = nullptr;
+  std::size_t m_size = 0;
+#ifdef _WIN32
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+#endif
+  std::vector<std::string> m_spacecraft_ids;
+  std::vector<index_entry> m_index;
+
+  template <typename T>
+  T read(const std::size_t offset) const
+  {
+    if (offset + sizeof(T) > m_size) {
+      throw std::runtime_error("Truncated binary trajectory file");
+    }
+    T value;
+    std::memcpy(&value, m_data + offset, sizeof(T));
+    return value;
+  }
+
+  void map(const std::string& path)
+  {
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error(fmt::format("Unable to open {}", path));
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(m_file, &size);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr) {
+      throw std::runtime_error(fmt::format("Unable to map {}", path));
+    }
+    m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error(fmt::format("Unable to open {}", path));
+    }
+    struct stat st{};
+    ::fstat(fd, &st);
+    m_size = static_cast<std::size_t>(st.st_size);
+    void* data = m_size > 0 ? ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      throw std::runtime_error(fmt::format("Unable to map {}", path));
+    }
+    m_data = static_cast<const unsigned char*>(data);
+#endif
+  }
+
+  void unmap()
+  {
+#ifdef _WIN32
+    if (m_data != nullptr) UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr) CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (m_data != nullptr) ::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  void parse_header(const std::string& path)
+  {
+    using namespace binary_trajectory;
+    if (m_size < file_magic.size() + trailer_size
+        || std::memcmp(m_data, file_magic.data(), file_magic.size()) != 0) {
+      throw std::runtime_error(fmt::format("{} is not a binary trajectory file", path));
+    }
+    std::size_t offset = file_magic.size();
+    if (const auto file_version = read<std::uint32_t>(offset); file_version != version) {
+      throw std::runtime_error(fmt::format("Unsupported binary trajectory version {} in {}", file_version, path));
+    }
+    offset += sizeof(std::uint32_t);
+    const auto n_columns = read<std::uint32_t>(offset);
+    if (n_columns != value_columns.size() + 1) {
+      throw std::runtime_error(fmt::format("Unexpected column count {} in {}", n_columns, path));
+    }
+    offset += sizeof(std::uint32_t) + n_columns * (8 + sizeof(std::uint32_t));
+
+    const auto n_spacecraft = read<std::uint32_t>(offset);
+    offset += sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < n_spacecraft; i++) {
+      const auto length = read<std::uint32_t>(offset);
+      offset += sizeof(std::uint32_t);
+      if (offset + length > m_size) {
+        throw std::runtime_error("Truncated binary trajectory file");
+      }
+      m_spacecraft_ids.emplace_back(reinterpret_cast<const char*>(m_data + offset), length);
+      offset += length;
+    }
+  }
+
+  void parse_index(const std::string& path)
+  {
+    using namespace binary_trajectory;
+    const std::size_t trailer = m_size - trailer_size;
+    if (std::memcmp(m_data + trailer + 2 * sizeof(std::uint64_t), index_magic.data(), index_magic.size()) != 0) {
+      throw std::runtime_error(fmt::format("{} has no chunk index, was it closed properly?", path));
+    }
+    const auto n_chunks = read<std::uint64_t>(trailer);
+    const auto index_offset = read<std::uint64_t>(trailer + sizeof(std::uint64_t));
+    m_index.resize(n_chunks);
+    for (std::size_t i = 0; i < n_chunks; i++) {
+      const std::size_t entry = index_offset + i * index_entry_size;
+      m_index[i] = {read<std::uint64_t>(entry),
+                    read<std::uint64_t>(entry + 8),
+                    read<double>(entry + 16),
+                    read<double>(entry + 24)};
+      const std::size_t chunk_end = m_index[i].offset + chunk_header_size
+          + padded(m_index[i].rows * sizeof(std::uint32_t)) + m_index[i].rows * value_columns.size() * sizeof(double);
+      if (chunk_end > m_size) {
+        throw std::runtime_error("Truncated binary trajectory file");
+      }
+    }
+  }
+
+public:
+  /**
+   * @param path Path of a file written by `binary_trajectory_writer_observer`
+   */
+  explicit trajectory_reader(const std::string& path)
+  {
+    binary_trajectory::check_byte_order();
+    map(path);
+    try {
+      parse_header(path);
+      parse_index(path);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  trajectory_reader(const trajectory_reader&) = delete;
+  trajectory_reader& operator=(const trajectory_reader&) = delete;
+
+  trajectory_reader(trajectory_reader&& other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr))
+      , m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+      , m_file(std::exchange(other.m_file, INVALID_HANDLE_VALUE))
+      , m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+      , m_spacecraft_ids(std::move(other.m_spacecraft_ids))
+      , m_index(std::move(other.m_index))
+  {
+  }
+
+  ~trajectory_reader()
+  {
+    unmap();
+  }
+
+  [[nodiscard]] const std::vector<std::string>& get_spacecraft_ids() const
+  {
+    return m_spacecraft_ids;
+  }
+
+  [[nodiscard]] std::size_t get_chunk_count() const
+  {
+    return m_index.size();
+  }
+
+  [[nodiscard]] std::size_t get_row_count() const
+  {
+    std::size_t rows = 0;
+    for (const auto& entry: m_index) rows += entry.rows;
+    return rows;
+  }
+
+  [[nodiscard]] trajectory_chunk get_chunk(const std::size_t i) const
+  {
+    const index_entry& entry = m_index.at(i);
+    const unsigned char* chunk = m_data + entry.offset + binary_trajectory::chunk_header_size;
+    const auto* scid = reinterpret_cast<const std::uint32_t*>(chunk);
+    const auto* columns = reinterpret_cast<const double*>(chunk + binary_trajectory::padded(entry.rows * sizeof(std::uint32_t)));
+    return {scid, columns, entry.rows};
+  }
+
+  /**
+   * @return Views of the rows with start_time <= t <= end_time, one per chunk
+   * holding any of them
+   */
+  [[nodiscard]] std::vector<trajectory_chunk> query(const double start_time, const double end_time) const
+  {
+    std::vector<trajectory_chunk> chunks;
+    for (std::size_t i = 0; i < m_index.size(); i++) {
+      if (m_index[i].t_max < start_time || m_index[i].t_min > end_time) continue;
+      if (trajectory_chunk rows = get_chunk(i).slice(start_time, end_time); rows.size() > 0) {
+        chunks.push_back(rows);
+      }
+    }
+    return chunks;
+  }
+};
+}
+
+#endif //BINARY_TRAJECTORY_H
@@ -0,0 +1,181 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef BINARY_TRAJECTORY_WRITER_OBSERVER_H
+#define BINARY_TRAJECTORY_WRITER_OBSERVER_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "observers/binary_trajectory.h"
+#include "observers/simulation_observer.h"
+
+namespace naomi::observers
+{
+/**
+ * Writes the observed spacecraft states to a binary columnar trajectory file
+ * (see `binary_trajectory`), read back with `trajectory_reader`.
+ *
+ * Rows are collected column by column and written as one chunk every
+ * `rows_per_chunk` rows, the chunk index is written on `terminate`.
+ */
+template<class system_t>
+class binary_trajectory_writer_observer: public simulation_observer<system_t>
+{
+  struct index_entry
+  {
+    std::uint64_t offset;
+    std::uint64_t rows;
+    double t_min;
+    double t_max;
+  };
+
+  std::string m_filepath;
+  std::ofstream m_fout;
+  std::size_t m_rows_per_chunk;
+  std::map<std::string, std::uint32_t> m_scids;
+  std::vector<std::uint32_t> m_scid_column;
+  std::array<std::vector<double>, binary_trajectory::value_columns.size()> m_columns;
+  std::vector<index_entry> m_index;
+
+  template <typename T>
+  void write(const T& value)
+  {
+    m_fout.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  void write(const std::vector<T>& values)
+  {
+    m_fout.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+  }
+
+  void pad()
+  {
+    const auto position = static_cast<std::size_t>(m_fout.tellp());
+    for (std::size_t i = position; i < binary_trajectory::padded(position); i++) {
+      m_fout.put(0);
+    }
+  }
+
+  void write_header(const std::shared_ptr<system_t>& system)
+  {
+    m_fout.write(binary_trajectory::file_magic.data(), binary_trajectory::file_magic.size());
+    write(binary_trajectory::version);
+    write(static_cast<std::uint32_t>(binary_trajectory::value_columns.size() + 1));
+
+    auto write_column = [this](const std::string& name, const std::uint32_t element_size)
+    {
+      std::array<char, 8> padded_name{};
+      name.copy(padded_name.data(), padded_name.size());
+      m_fout.write(padded_name.data(), padded_name.size());
+      write(element_size);
+    };
+    write_column("scid", sizeof(std::uint32_t));
+    for (const char* name: binary_trajectory::value_columns) {
+      write_column(name, sizeof(double));
+    }
+
+    const auto spacecrafts = system->get_spacecrafts();
+    write(static_cast<std::uint32_t>(spacecrafts.size()));
+    for (const auto& [id, sc]: spacecrafts) {
+      m_scids.emplace(id, static_cast<std::uint32_t>(m_scids.size()));
+      write(static_cast<std::uint32_t>(id.size()));
+      m_fout.write(id.data(), static_cast<std::streamsize>(id.size()));
+    }
+    pad();
+  }
+
+  void write_chunk()
+  {
+    const std::vector<double>& t = m_columns[static_cast<std::size_t>(trajectory_column::T)];
+    if (t.empty()) {
+      return;
+    }
+    const index_entry entry = {static_cast<std::uint64_t>(m_fout.tellp()), static_cast<std::uint64_t>(t.size()), t.front(), t.back()};
+    write(entry.rows);
+    write(entry.t_min);
+    write(entry.t_max);
+    write(m_scid_column);
+    pad();
+    for (auto& column: m_columns) {
+      write(column);
+      column.clear();
+    }
+    m_scid_column.clear();
+    m_index.push_back(entry);
+  }
+
+public:
+  /**
+   * @param obs_interval Observation interval in seconds
+   * @param filepath Path of the trajectory file, overwritten
+   * @param rows_per_chunk Rows buffered before a chunk is written
+   */
+  binary_trajectory_writer_observer(const double obs_interval, std::string filepath, const std::size_t rows_per_chunk = 1 << 16)
+      : simulation_observer<system_t>(obs_interval), m_filepath(std::move(filepath)), m_rows_per_chunk(rows_per_chunk)
+  {
+  }
+
+  void initialize(const std::shared_ptr<system_t>& system) override
+  {
+    binary_trajectory::check_byte_order();
+    m_fout.open(m_filepath, std::ios::out | std::ios::binary);
+    if (! m_fout) {
+      throw std::runtime_error(fmt::format("Unable to open {} for writing", m_filepath));
+    }
+    write_header(system);
+    this->observe_state(system);
+  }
+
+  void handle_observe_state(const std::shared_ptr<system_t>& system) override
+  {
+    const double t = system->get_current_time();
+    for (const auto& [id, sc]: system->get_spacecrafts()) {
+      const auto scid = m_scids.find(id);
+      if (scid == m_scids.end()) {
+        throw std::runtime_error(fmt::format("Spacecraft {} was added after the trajectory header was written", id));
+      }
+      m_scid_column.push_back(scid->second);
+      const vector_type pv = sc->get_pv_coordinates().to_vec();
+      const quaternion_type attitude = sc->get_attitude();
+      std::size_t column = 0;
+      m_columns[column++].push_back(t);
+      for (std::size_t i = 0; i < 6; i++) m_columns[column++].push_back(pv(i));
+      for (std::size_t i = 0; i < 4; i++) m_columns[column++].push_back(attitude(i));
+    }
+    if (m_scid_column.size() >= m_rows_per_chunk) {
+      write_chunk();
+    }
+  }
+
+  /**
+   * Writes the remaining rows and the chunk index.
+   */
+  void terminate(const std::shared_ptr<system_t>& system) override
+  {
+    write_chunk();
+    const auto index_offset = static_cast<std::uint64_t>(m_fout.tellp());
+    for (const index_entry& entry: m_index) {
+      write(entry.offset);
+      write(entry.rows);
+      write(entry.t_min);
+      write(entry.t_max);
+    }
+    write(static_cast<std::uint64_t>(m_index.size()));
+    write(index_offset);
+    m_fout.write(binary_trajectory::index_magic.data(), binary_trajectory::index_magic.size());
+    m_fout.close();
+  }
+};
+}
+
+#endif //BINARY_TRAJECTORY_WRITER_OBSERVER_H
@@ -0,0 +1,112 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef CHEBYSHEV_EPHEMERIS_OBSERVER_H
+#define CHEBYSHEV_EPHEMERIS_OBSERVER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "observers/simulation_observer.h"
+#include "orbits/chebyshev_ephemeris.h"
+
+namespace naomi::observers
+{
+/**
+ * Exports the observed trajectories as Chebyshev ephemerides (see
+ * `orbits::chebyshev_ephemeris`), read back with
+ * `orbits::read_chebyshev_ephemerides`.
+ *
+ * The observed states of every spacecraft are collected until a segment is
+ * complete and then fitted, the last sample of a segment also starts the
+ * next one.  The observation interval only needs to be short enough for the
+ * samples to pin down the segment polynomials, the position and velocity of
+ * each sample both enter the fit.  Every other sample is held out to check
+ * the fit between the fitted ones, where the samples are too sparse for that
+ * (e.g. a final segment of two samples) fitting throws instead of writing an
+ * unchecked segment.
+ */
+template<class system_t>
+class chebyshev_ephemeris_observer: public simulation_observer<system_t>
+{
+  struct pending_samples
+  {
+    std::vector<double> times;
+    std::vector<pv_state_type> states;
+  };
+
+  std::string m_filepath;
+  double m_segment_length;
+  double m_tolerance;
+  std::size_t m_max_degree;
+  std::map<std::string, pending_samples> m_samples;
+  std::map<std::string, orbits::chebyshev_ephemeris> m_ephemerides;
+
+  void fit_pending(const std::string& id, pending_samples& samples)
+  {
+    if (samples.times.size() < 2) {
+      return;
+    }
+    m_ephemerides[id].fit(samples.times, samples.states, samples.times.front(), samples.times.back(), m_tolerance, m_max_degree);
+    samples.times.erase(samples.times.begin(), samples.times.end() - 1);
+    samples.states.erase(samples.states.begin(), samples.states.end() - 1);
+  }
+
+public:
+  /**
+   * @param obs_interval Observation interval in seconds
+   * @param filepath Path of the ephemeris file, written on `terminate`
+   * @param segment_length Length of the segments in seconds, shortened where
+   * needed to meet the tolerance
+   * @param tolerance Largest position error of the fit in meters
+   * @param max_degree Highest degree of the segments
+   */
+  chebyshev_ephemeris_observer(const double obs_interval,
+                               std::string filepath,
+                               const double segment_length,
+                               const double tolerance = 1e-3,
+                               const std::size_t max_degree = 15)
+      : simulation_observer<system_t>(obs_interval)
+      , m_filepath(std::move(filepath))
+      , m_segment_length(segment_length)
+      , m_tolerance(tolerance)
+      , m_max_degree(max_degree)
+  {
+  }
+
+  void initialize(const std::shared_ptr<system_t>& system) override
+  {
+    this->observe_state(system);
+  }
+
+  void handle_observe_state(const std::shared_ptr<system_t>& system) override
+  {
+    const double t = system->get_current_time();
+    for (const auto& [id, sc]: system->get_spacecrafts()) {
+      pending_samples& samples = m_samples[id];
+      samples.times.push_back(t);
+      samples.states.push_back(sc->get_pv_coordinates().to_vec().subvec(0, 5));
+      if (t - samples.times.front() >= m_segment_length) {
+        fit_pending(id, samples);
+      }
+    }
+  }
+
+  void terminate(const std::shared_ptr<system_t>& system) override
+  {
+    for (auto& [id, samples]: m_samples) {
+      fit_pending(id, samples);
+    }
+    orbits::write_chebyshev_ephemerides(m_filepath, m_ephemerides);
+  }
+
+  [[nodiscard]] const std::map<std::string, orbits::chebyshev_ephemeris>& get_ephemerides() const
+  {
+    return m_ephemerides;
+  }
+};
+}
+
+#endif //CHEBYSHEV_EPHEMERIS_OBSERVER_H
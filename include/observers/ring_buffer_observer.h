@@ -0,0 +1,248 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef RING_BUFFER_OBSERVER_H
+#define RING_BUFFER_OBSERVER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "observers/binary_trajectory.h"
+#include "observers/simulation_observer.h"
+
+namespace naomi::observers
+{
+constexpr std::size_t history_column_count = binary_trajectory::value_columns.size();
+
+/**
+ * View of the samples of a `state_history` at the time it was taken.  The
+ * ring may have wrapped, so each column is split into the older and the newer
+ * part.
+ */
+struct history_snapshot
+{
+  /// Sequence number of the oldest sample in the views
+  std::uint64_t first_sequence = 0;
+  /// One past the sequence number of the newest sample
+  std::uint64_t end_sequence = 0;
+  std::array<std::array<column_view<double>, 2>, history_column_count> columns;
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return end_sequence - first_sequence;
+  }
+
+  /**
+   * @return The older and the newer part of a column, oldest sample first
+   */
+  [[nodiscard]] const std::array<column_view<double>, 2>& get_column(const trajectory_column column) const
+  {
+    return columns[static_cast<std::size_t>(column)];
+  }
+
+  /**
+   * @param column The column
+   * @param i Index of the sample, 0 is the oldest
+   */
+  [[nodiscard]] double at(const trajectory_column column, const std::size_t i) const
+  {
+    const auto& [older, newer] = get_column(column);
+    return i < older.size() ? older[i] : newer[i - older.size()];
+  }
+};
+
+/**
+ * Fixed capacity ring of the most recent states of one spacecraft, stored as
+ * one preallocated array per column (t, x, y, z, vx, vy, vz, q0, q1, q2, q3).
+ *
+ * One writer thread appends samples while any number of reader threads take
+ * snapshots without locks.  Snapshots are views into the ring, so the writer
+ * may overwrite the oldest samples of a snapshot while it is read; readers
+ * check `is_intact` after consuming a snapshot, like the read side of a
+ * seqlock, and retry or drop the overwritten samples.
+ *
+ * The samples are plain doubles so that snapshots can hand out contiguous
+ * column views.  A read that overlaps the overwrite of the same sample is
+ * therefore a data race in the C++ memory model (and reported by
+ * ThreadSanitizer); it is benign here because aligned doubles are written
+ * with single stores on the supported platforms and every sample it can
+ * affect is reported by `get_overwritten_count`.  Samples that count as
+ * intact are never written concurrently with the read.
+ */
+class state_history
+{
+  std::size_t m_capacity;
+  std::vector<double> m_data;
+  /// Samples whose write has started, ahead of `m_published` during a write
+  std::atomic<std::uint64_t> m_started = 0;
+  /// Samples completely written
+  std::atomic<std::uint64_t> m_published = 0;
+
+  double* column(const std::size_t c)
+  {
+    return m_data.data() + c * m_capacity;
+  }
+
+  [[nodiscard]] const double* column(const std::size_t c) const
+  {
+    return m_data.data() + c * m_capacity;
+  }
+
+public:
+  /**
+   * @param capacity The number of samples kept
+   */
+  explicit state_history(const std::size_t capacity)
+      : m_capacity(capacity), m_data(capacity * history_column_count)
+  {
+    if (capacity == 0) {
+      throw std::runtime_error("State history capacity must be positive");
+    }
+  }
+
+  [[nodiscard]] std::size_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * Writer side, appends a sample and overwrites the oldest once full.
+   */
+  void push(const double t, const vector_type& pv, const quaternion_type& attitude)
+  {
+    const std::uint64_t sequence = m_published.load(std::memory_order_relaxed);
+    m_started.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const std::size_t slot = sequence % m_capacity;
+    std::size_t c = 0;
+    column(c++)[slot] = t;
+    for (std::size_t i = 0; i < 6; i++) column(c++)[slot] = pv(i);
+    for (std::size_t i = 0; i < 4; i++) column(c++)[slot] = attitude(i);
+
+    m_published.store(sequence + 1, std::memory_order_release);
+  }
+
+  /**
+   * @return The number of samples pushed so far, the newest sample has
+   * sequence number `get_sequence() - 1`
+   */
+  [[nodiscard]] std::uint64_t get_sequence() const
+  {
+    return m_published.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Reader side, views of the newest samples.
+   *
+   * @param max_samples Upper bound on the number of samples in the snapshot
+   */
+  [[nodiscard]] history_snapshot snapshot(const std::size_t max_samples = std::numeric_limits<std::size_t>::max()) const
+  {
+    history_snapshot snap;
+    snap.end_sequence = m_published.load(std::memory_order_acquire);
+    const std::uint64_t count = std::min<std::uint64_t>({snap.end_sequence, static_cast<std::uint64_t>(m_capacity), static_cast<std::uint64_t>(max_samples)});
+    snap.first_sequence = snap.end_sequence - count;
+
+    const std::size_t first_slot = snap.first_sequence % m_capacity;
+    const std::size_t older = std::min<std::size_t>(count, m_capacity - first_slot);
+    for (std::size_t c = 0; c < history_column_count; c++) {
+      snap.columns[c][0] = {column(c) + first_slot, older};
+      snap.columns[c][1] = {column(c), count - older};
+    }
+    return snap;
+  }
+
+  /**
+   * Call after reading a snapshot.
+   *
+   * @return The number of leading (oldest) samples of `snap` the writer may
+   * have overwritten while it was read, 0 if the whole snapshot is intact
+   */
+  [[nodiscard]] std::size_t get_overwritten_count(const history_snapshot& snap) const
+  {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t started = m_started.load(std::memory_order_relaxed);
+    const std::uint64_t oldest_intact = started > m_capacity ? started - m_capacity : 0;
+    if (oldest_intact <= snap.first_sequence) return 0;
+    return std::min<std::uint64_t>(oldest_intact - snap.first_sequence, snap.size());
+  }
+
+  [[nodiscard]] bool is_intact(const history_snapshot& snap) const
+  {
+    return get_overwritten_count(snap) == 0;
+  }
+};
+
+/**
+ * Keeps the most recent `capacity` observed states of every spacecraft in
+ * memory for consumers in the same process, e.g. controllers or live
+ * dashboards, which read them from other threads through `get_history`.
+ * The rings are allocated once in `initialize`.
+ */
+template<class system_t>
+class ring_buffer_observer: public simulation_observer<system_t>
+{
+  std::size_t m_capacity;
+  std::map<std::string, std::shared_ptr<state_history>> m_histories;
+
+  [[nodiscard]] const std::shared_ptr<state_history>& find_history(const std::string& id) const
+  {
+    const auto it = m_histories.find(id);
+    if (it == m_histories.end()) {
+      throw std::runtime_error(fmt::format("No history for spacecraft {}", id));
+    }
+    return it->second;
+  }
+
+public:
+  /**
+   * @param obs_interval Observation interval in seconds
+   * @param capacity Number of samples kept per spacecraft
+   */
+  ring_buffer_observer(const double obs_interval, const std::size_t capacity)
+      : simulation_observer<system_t>(obs_interval), m_capacity(capacity)
+  {
+  }
+
+  void initialize(const std::shared_ptr<system_t>& system) override
+  {
+    for (const auto& [id, sc]: system->get_spacecrafts()) {
+      m_histories.emplace(id, std::make_shared<state_history>(m_capacity));
+    }
+    this->observe_state(system);
+  }
+
+  void handle_observe_state(const std::shared_ptr<system_t>& system) override
+  {
+    const double t = system->get_current_time();
+    for (const auto& [id, sc]: system->get_spacecrafts()) {
+      find_history(id)->push(t, sc->get_pv_coordinates().to_vec(), sc->get_attitude());
+    }
+  }
+
+  /**
+   * Safe to call from any thread once the simulation is initialized.
+   *
+   * @param id The spacecraft identifier
+   * @return The history of the spacecraft
+   */
+  [[nodiscard]] std::shared_ptr<const state_history> get_history(const std::string& id) const
+  {
+    return find_history(id);
+  }
+};
+}
+
+#endif //RING_BUFFER_OBSERVER_H
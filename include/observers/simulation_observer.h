@@ -5,8 +5,11 @@
 #ifndef SIMULATION_OBSERVER_H
 #define SIMULATION_OBSERVER_H
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
+#include <fmt/core.h>
+
 #include "propagators/event_detector.h"
 #include "spacecraft/pv_coordinates.h"
 
@@ -22,7 +25,12 @@ class simulation_observer
 
 public:
   virtual ~simulation_observer() = default;
-  explicit simulation_observer(const double obs_interval): m_obs_interval(obs_interval){}
+  explicit simulation_observer(const double obs_interval): m_obs_interval(obs_interval)
+  {
+    if (obs_interval <= 0) {
+      throw std::runtime_error(fmt::format("Observation interval must be positive, got {}", obs_interval));
+    }
+  }
   virtual void initialize(const std::shared_ptr<system_t>& system){}
   void observe_state(const std::shared_ptr<system_t>& system)
   {
@@ -71,7 +79,7 @@ public:
       auto attitude = sc->get_attitude();
       m_fout << id << ",";
       m_fout << pos[0]  << "," << pos[1] << "," << pos[2] << ",";
-      m_fout << pos[3]  << "," << pos[4] << "," << pos[5] << ",";
+      m_fout << vel[0]  << "," << vel[1] << "," << vel[2] << ",";
       m_fout << attitude[0] << "," << attitude[1] << "," << attitude[2] << "," << attitude[3] << "\n";
     }
   }
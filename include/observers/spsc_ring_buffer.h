@@ -0,0 +1,97 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/core.h>
+
+namespace naomi::observers
+{
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * The producer only writes the tail and the consumer only writes the head, so
+ * pushing and popping never block each other.  Each index lives on its own
+ * cache line to keep the two threads from invalidating each other's line on
+ * every operation.
+ *
+ * @tparam T Trivially copyable element type
+ */
+template <typename T>
+class spsc_ring_buffer
+{
+  static constexpr std::size_t cache_line_size = 64;
+
+  std::vector<T> m_buffer;
+  std::size_t m_mask;
+  alignas(cache_line_size) std::atomic<std::size_t> m_head = 0;
+  alignas(cache_line_size) std::atomic<std::size_t> m_tail = 0;
+
+public:
+  /**
+   * @param capacity The number of elements, a power of two
+   */
+  explicit spsc_ring_buffer(const std::size_t capacity)
+      : m_buffer(capacity), m_mask(capacity - 1)
+  {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::runtime_error(fmt::format("Ring buffer capacity must be a power of two, got {}", capacity));
+    }
+  }
+
+  [[nodiscard]] std::size_t capacity() const
+  {
+    return m_buffer.size();
+  }
+
+  /**
+   * Producer side.
+   *
+   * @return False if the buffer is full and `value` wasn't queued
+   */
+  bool try_push(const T& value)
+  {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_buffer.size()) {
+      return false;
+    }
+    m_buffer[tail & m_mask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side.
+   *
+   * @return False if the buffer is empty and `value` is unchanged
+   */
+  bool try_pop(T& value)
+  {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = m_buffer[head & m_mask];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @return True if nothing is queued, only exact when called by the consumer
+   * while the producer is idle
+   */
+  [[nodiscard]] bool empty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+};
+}
+
+#endif //SPSC_RING_BUFFER_H
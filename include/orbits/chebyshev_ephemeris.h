@@ -0,0 +1,424 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef CHEBYSHEV_EPHEMERIS_H
+#define CHEBYSHEV_EPHEMERIS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "naomi.h"
+
+namespace naomi::orbits
+{
+/**
+ * Values and derivatives of the Chebyshev polynomials T_0 ... T_n at x in
+ * [-1, 1], from the recurrences T_k+1 = 2x T_k - T_k-1 and its derivative.
+ */
+inline void chebyshev_basis(const double x, const std::size_t degree, double* t, double* dt)
+{
+  t[0] = 1;
+  dt[0] = 0;
+  if (degree == 0) return;
+  t[1] = x;
+  dt[1] = 1;
+  for (std::size_t k = 1; k < degree; k++) {
+    t[k + 1] = 2 * x * t[k] - t[k - 1];
+    dt[k + 1] = 2 * t[k] + 2 * x * dt[k] - dt[k - 1];
+  }
+}
+
+/**
+ * Chebyshev series of the position over [start, end], the velocity is its
+ * derivative.
+ */
+struct chebyshev_segment
+{
+  double start;
+  double end;
+  /// (degree + 1) x 3, the series coefficients of x, y and z
+  arma::mat coefficients;
+
+  [[nodiscard]] std::size_t get_degree() const
+  {
+    return coefficients.n_rows - 1;
+  }
+
+  [[nodiscard]] double to_unit(const double t) const
+  {
+    return (2 * t - start - end) / (end - start);
+  }
+
+  [[nodiscard]] pv_state_type evaluate(const double t) const
+  {
+    const std::size_t n = coefficients.n_rows;
+    std::array<double, 64> basis{};
+    std::array<double, 64> basis_derivative{};
+    chebyshev_basis(to_unit(t), n - 1, basis.data(), basis_derivative.data());
+    pv_state_type pv(arma::fill::zeros);
+    const double scale = 2 / (end - start);
+    for (std::size_t k = 0; k < n; k++) {
+      for (std::size_t j = 0; j < 3; j++) {
+        pv(j) += basis[k] * coefficients(k, j);
+        pv(3 + j) += scale * basis_derivative[k] * coefficients(k, j);
+      }
+    }
+    return pv;
+  }
+};
+
+/**
+ * Least squares Chebyshev fit of sampled positions and velocities, the
+ * velocities constrain the derivative of the series so fewer samples are
+ * needed than coefficients fitted.
+ *
+ * Every other sample is held out of the fit and only used to check it, the
+ * tolerance is therefore verified between the fitted samples and not just at
+ * them, where a fit of few samples is close to interpolating.  At least 3
+ * samples are needed.
+ *
+ * @param times Sample times within [start, end]
+ * @param states Position and velocity at each sample time
+ * @param start Start of the segment
+ * @param end End of the segment
+ * @param tolerance Largest position error at the samples in meters
+ * @param max_degree Highest degree tried, at most 63
+ * @return The lowest degree fit meeting the tolerance, nothing if none does
+ * or there are too few samples to check it
+ */
+inline std::optional<chebyshev_segment> fit_chebyshev_segment(const std::vector<double>& times,
+                                                              const std::vector<pv_state_type>& states,
+                                                              const double start,
+                                                              const double end,
+                                                              const double tolerance,
+                                                              const std::size_t max_degree = 15)
+{
+  const std::size_t m = times.size();
+  if (m < 3) {
+    return std::nullopt;
+  }
+  const arma::uvec fitted_rows = arma::regspace<arma::uvec>(0, 2, m - 1);
+  const std::size_t highest = std::min({max_degree, static_cast<std::size_t>(63), 2 * fitted_rows.n_elem - 1});
+  chebyshev_segment segment{start, end, {}};
+
+  arma::mat basis(m, highest + 1);
+  arma::mat basis_derivative(m, highest + 1);
+  arma::mat positions(m, 3);
+  arma::mat velocities(m, 3);
+  std::array<double, 64> t{};
+  std::array<double, 64> dt{};
+  for (std::size_t i = 0; i < m; i++) {
+    chebyshev_basis(segment.to_unit(times[i]), highest, t.data(), dt.data());
+    for (std::size_t k = 0; k <= highest; k++) {
+      basis(i, k) = t[k];
+      basis_derivative(i, k) = dt[k];
+    }
+    positions.row(i) = states[i].subvec(0, 2).t();
+    // d/dx = (end - start) / 2 d/dt
+    velocities.row(i) = 0.5 * (end - start) * states[i].subvec(3, 5).t();
+  }
+  const arma::mat fitted_basis = basis.rows(fitted_rows);
+  const arma::mat fitted_basis_derivative = basis_derivative.rows(fitted_rows);
+  const arma::mat b = arma::join_cols(positions.rows(fitted_rows), velocities.rows(fitted_rows));
+
+  for (std::size_t degree = std::min<std::size_t>(3, highest); degree <= highest; degree++) {
+    const arma::mat a = arma::join_cols(fitted_basis.cols(0, degree), fitted_basis_derivative.cols(0, degree));
+    arma::mat coefficients;
+    if (! arma::solve(coefficients, a, b)) continue;
+    // Checked at all samples, the held out ones included
+    const arma::mat residual = basis.cols(0, degree) * coefficients - positions;
+    if (arma::max(arma::sqrt(arma::sum(arma::square(residual), 1))) <= tolerance) {
+      segment.coefficients = coefficients;
+      return segment;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * Trajectory of one spacecraft stored as consecutive Chebyshev segments, in
+ * the spirit of SPK type 2/3 ephemerides.  A state at any time costs a single
+ * series evaluation.
+ */
+class chebyshev_ephemeris
+{
+  std::vector<chebyshev_segment> m_segments;
+
+  /**
+   * Fit `state_at` over [start, end] from 2 max_degree + 1 evenly spaced
+   * samples, of which every other one is held out to check the fit.
+   */
+  void fit_function(const std::function<pv_state_type(double)>& state_at,
+                    const double start,
+                    const double end,
+                    const double tolerance,
+                    const std::size_t max_degree,
+                    const std::size_t halvings)
+  {
+    const std::size_t samples = 2 * max_degree + 1;
+    std::vector<double> times(samples);
+    std::vector<pv_state_type> states(samples);
+    for (std::size_t i = 0; i < samples; i++) {
+      times[i] = start + (end - start) * static_cast<double>(i) / static_cast<double>(samples - 1);
+      states[i] = state_at(times[i]);
+    }
+    if (auto segment = fit_chebyshev_segment(times, states, start, end, tolerance, max_degree)) {
+      append(std::move(*segment));
+      return;
+    }
+    if (halvings == max_halvings) {
+      throw std::runtime_error(fmt::format(
+          "Unable to fit [{}, {}] to {} m after {} halvings", start, end, tolerance, halvings));
+    }
+    const double mid = 0.5 * (start + end);
+    fit_function(state_at, start, mid, tolerance, max_degree, halvings + 1);
+    fit_function(state_at, mid, end, tolerance, max_degree, halvings + 1);
+  }
+
+public:
+  /// Segments of `from_function` are at least 2^-max_halvings of the
+  /// requested segment length
+  static constexpr std::size_t max_halvings = 16;
+
+  chebyshev_ephemeris() = default;
+  explicit chebyshev_ephemeris(std::vector<chebyshev_segment> segments): m_segments(std::move(segments)){}
+
+  /**
+   * Fit the samples within [start, end], halving the segment until the fit
+   * meets the tolerance at the held out samples.
+   *
+   * @throws std::runtime_error If a half has too few samples to check its
+   * fit
+   */
+  void fit(const std::vector<double>& times,
+           const std::vector<pv_state_type>& states,
+           const double start,
+           const double end,
+           const double tolerance,
+           const std::size_t max_degree = 15)
+  {
+    if (auto segment = fit_chebyshev_segment(times, states, start, end, tolerance, max_degree)) {
+      append(std::move(*segment));
+      return;
+    }
+    const double mid = 0.5 * (start + end);
+    std::vector<double> lower_times, upper_times;
+    std::vector<pv_state_type> lower_states, upper_states;
+    for (std::size_t i = 0; i < times.size(); i++) {
+      // The sample at mid belongs to both halves
+      if (times[i] <= mid) {
+        lower_times.push_back(times[i]);
+        lower_states.push_back(states[i]);
+      }
+      if (times[i] >= mid) {
+        upper_times.push_back(times[i]);
+        upper_states.push_back(states[i]);
+      }
+    }
+    if (lower_times.size() < 3 || upper_times.size() < 3) {
+      throw std::runtime_error(fmt::format(
+          "Unable to fit [{}, {}] to {} m, sample the trajectory more densely", start, end, tolerance));
+    }
+    fit(lower_times, lower_states, start, mid, tolerance, max_degree);
+    fit(upper_times, upper_states, mid, end, tolerance, max_degree);
+  }
+
+  /**
+   * Fit a trajectory given as a function of time, e.g. the dense output of a
+   * propagation.  Segments failing the tolerance are halved and each half is
+   * sampled anew.
+   *
+   * @param state_at Position and velocity at a time
+   * @param start_time Start of the ephemeris
+   * @param end_time End of the ephemeris
+   * @param segment_length Length of the segments in seconds, shortened where
+   * needed to meet the tolerance
+   * @param tolerance Largest position error at the samples in meters
+   * @param max_degree Highest degree of the segments
+   * @throws std::runtime_error If a segment still fails the tolerance after
+   * `max_halvings` halvings
+   */
+  static chebyshev_ephemeris from_function(const std::function<pv_state_type(double)>& state_at,
+                                           const double start_time,
+                                           const double end_time,
+                                           const double segment_length,
+                                           const double tolerance,
+                                           const std::size_t max_degree = 15)
+  {
+    chebyshev_ephemeris ephemeris;
+    for (double start = start_time; start < end_time; start += segment_length) {
+      const double end = std::min(start + segment_length, end_time);
+      ephemeris.fit_function(state_at, start, end, tolerance, max_degree, 0);
+    }
+    return ephemeris;
+  }
+
+  void append(chebyshev_segment segment)
+  {
+    if (! m_segments.empty() && segment.start < m_segments.back().end) {
+      throw std::runtime_error(fmt::format(
+          "Segment starting at {} overlaps the ephemeris ending at {}", segment.start, m_segments.back().end));
+    }
+    m_segments.push_back(std::move(segment));
+  }
+
+  [[nodiscard]] const std::vector<chebyshev_segment>& get_segments() const
+  {
+    return m_segments;
+  }
+
+  [[nodiscard]] double get_start_time() const
+  {
+    return m_segments.front().start;
+  }
+
+  [[nodiscard]] double get_end_time() const
+  {
+    return m_segments.back().end;
+  }
+
+  /**
+   * @return The number of stored coefficients
+   */
+  [[nodiscard]] std::size_t get_coefficient_count() const
+  {
+    std::size_t count = 0;
+    for (const auto& segment: m_segments) count += segment.coefficients.n_elem;
+    return count;
+  }
+
+  /**
+   * @param t Time within the ephemeris
+   * @return Position and velocity at `t`
+   */
+  [[nodiscard]] pv_state_type get_state(const double t) const
+  {
+    if (m_segments.empty() || t < get_start_time() || t > get_end_time()) {
+      throw std::runtime_error(fmt::format("t = {} is outside of the ephemeris", t));
+    }
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), t,
+                               [](const double time, const chebyshev_segment& segment) { return time < segment.start; });
+    return std::prev(it)->evaluate(t);
+  }
+};
+
+/**
+ * Binary file of named Chebyshev ephemerides, little-endian:
+ * magic "NAOMICHB", u32 version, u32 ephemeris count, then per ephemeris the
+ * u32 name length, the name, u64 segment count and per segment f64 start,
+ * f64 end, u32 degree and the (degree + 1) x 3 f64 coefficients column by
+ * column.
+ */
+namespace chebyshev_file
+{
+constexpr std::array<char, 8> magic = {'N', 'A', 'O', 'M', 'I', 'C', 'H', 'B'};
+constexpr std::uint32_t version = 1;
+
+/**
+ * Values are copied to and from the file as they are in memory, so reading
+ * and writing is only supported on little-endian hosts.
+ */
+inline void check_byte_order()
+{
+  constexpr std::uint16_t probe = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &probe, 1);
+  if (first_byte != 1) {
+    throw std::runtime_error("Chebyshev ephemeris files require a little-endian host");
+  }
+}
+}
+
+inline void write_chebyshev_ephemerides(const std::string& path, const std::map<std::string, chebyshev_ephemeris>& ephemerides)
+{
+  chebyshev_file::check_byte_order();
+  std::ofstream fout(path, std::ios::out | std::ios::binary);
+  if (! fout) {
+    throw std::runtime_error(fmt::format("Unable to open {} for writing", path));
+  }
+  auto write = [&fout](const auto& value) { fout.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+  fout.write(chebyshev_file::magic.data(), chebyshev_file::magic.size());
+  write(chebyshev_file::version);
+  write(static_cast<std::uint32_t>(ephemerides.size()));
+  for (const auto& [name, ephemeris]: ephemerides) {
+    write(static_cast<std::uint32_t>(name.size()));
+    fout.write(name.data(), static_cast<std::streamsize>(name.size()));
+    write(static_cast<std::uint64_t>(ephemeris.get_segments().size()));
+    for (const auto& segment: ephemeris.get_segments()) {
+      write(segment.start);
+      write(segment.end);
+      write(static_cast<std::uint32_t>(segment.get_degree()));
+      fout.write(reinterpret_cast<const char*>(segment.coefficients.memptr()),
+                 static_cast<std::streamsize>(segment.coefficients.n_elem * sizeof(double)));
+    }
+  }
+}
+
+inline std::map<std::string, chebyshev_ephemeris> read_chebyshev_ephemerides(const std::string& path)
+{
+  chebyshev_file::check_byte_order();
+  std::ifstream fin(path, std::ios::in | std::ios::binary);
+  if (! fin) {
+    throw std::runtime_error(fmt::format("Unable to open {}", path));
+  }
+  auto read_bytes = [&fin, &path](char* data, const std::size_t size)
+  {
+    if (! fin.read(data, static_cast<std::streamsize>(size))) {
+      throw std::runtime_error(fmt::format("Truncated Chebyshev ephemeris file {}", path));
+    }
+  };
+  auto read = [&read_bytes](auto& value)
+  {
+    read_bytes(reinterpret_cast<char*>(&value), sizeof(value));
+  };
+  std::array<char, 8> magic{};
+  read(magic);
+  std::uint32_t version = 0;
+  read(version);
+  if (magic != chebyshev_file::magic || version != chebyshev_file::version) {
+    throw std::runtime_error(fmt::format("{} is not a Chebyshev ephemeris file", path));
+  }
+
+  std::map<std::string, chebyshev_ephemeris> ephemerides;
+  std::uint32_t n_ephemerides = 0;
+  read(n_ephemerides);
+  for (std::uint32_t e = 0; e < n_ephemerides; e++) {
+    std::uint32_t name_length = 0;
+    read(name_length);
+    std::string name(name_length, '\0');
+    read_bytes(name.data(), name_length);
+    std::uint64_t n_segments = 0;
+    read(n_segments);
+    std::vector<chebyshev_segment> segments(n_segments);
+    for (auto& segment: segments) {
+      std::uint32_t degree = 0;
+      read(segment.start);
+      read(segment.end);
+      read(degree);
+      if (degree > 63) {
+        throw std::runtime_error(fmt::format("Unsupported Chebyshev degree {} in {}", degree, path));
+      }
+      segment.coefficients.set_size(degree + 1, 3);
+      read_bytes(reinterpret_cast<char*>(segment.coefficients.memptr()), segment.coefficients.n_elem * sizeof(double));
+    }
+    ephemerides.emplace(name, chebyshev_ephemeris(std::move(segments)));
+  }
+  return ephemerides;
+}
+}
+
+#endif //CHEBYSHEV_EPHEMERIS_H
@@ -0,0 +1,224 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef EQUINOCTIAL_H
+#define EQUINOCTIAL_H
+
+#include <cmath>
+
+#include <armadillo>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "constants.h"
+#include "naomi.h"
+#include "orbits/cartesian.h"
+#include "orbits/keplerian.h"
+
+namespace naomi::orbits
+{
+/**
+ * Modified equinoctial elements (Walker, Ireland and Owens 1985)
+ *
+ *     p = a (1 - e^2)
+ *     f = e cos(aop + raan),  g = e sin(aop + raan)
+ *     h = tan(i/2) cos(raan), k = tan(i/2) sin(raan)
+ *     L = raan + aop + true anomaly
+ *
+ * which, unlike the Keplerian elements, are regular for circular and
+ * equatorial orbits (e.g. the `ecc = 0`, `inc = 0` orbits of a Hohmann
+ * transfer).  Only exactly retrograde equatorial orbits (i = 180 deg) are
+ * singular.  The true longitude L is not wrapped so it stays continuous
+ * while integrated.
+ */
+class equinoctial_orbit
+{
+  double m_p;
+  double m_f;
+  double m_g;
+  double m_h;
+  double m_k;
+  double m_l;
+
+public:
+  equinoctial_orbit(const double p, const double f, const double g, const double h, const double k, const double l)
+      : m_p(p), m_f(f), m_g(g), m_h(h), m_k(k), m_l(l){}
+
+  /**
+   * @param elements p, f, g, h, k, L
+   */
+  explicit equinoctial_orbit(const pv_state_type& elements)
+      : equinoctial_orbit(elements(0), elements(1), elements(2), elements(3), elements(4), elements(5)){}
+
+  static equinoctial_orbit from_cartesian(const arma::vec3& r, const arma::vec3& v, const double mu = constants::EARTH_MU)
+  {
+    const double rn = arma::norm(r);
+    const arma::vec3 h_vec = arma::cross(r, v);
+    const double hn = arma::norm(h_vec);
+    const arma::vec3 w_hat = h_vec / hn;
+    const double p = hn * hn / mu;
+
+    const double h = -w_hat(1) / (1 + w_hat(2));
+    const double k = w_hat(0) / (1 + w_hat(2));
+    // Equinoctial frame, f_hat points along the node line rotated back by raan
+    const double s2 = 1 + h * h + k * k;
+    const arma::vec3 f_hat = arma::vec3{1 - k * k + h * h, 2 * k * h, -2 * k} / s2;
+    const arma::vec3 g_hat = arma::vec3{2 * k * h, 1 + k * k - h * h, 2 * h} / s2;
+
+    const arma::vec3 e_vec = arma::cross(v, h_vec) / mu - r / rn;
+    const double f = arma::dot(e_vec, f_hat);
+    const double g = arma::dot(e_vec, g_hat);
+    const double l = std::atan2(arma::dot(r, g_hat), arma::dot(r, f_hat));
+    return {p, f, g, h, k, l};
+  }
+
+  static equinoctial_orbit from_cartesian(cartesian_orbit& cart, const double mu = constants::EARTH_MU)
+  {
+    return from_cartesian(cart.get_position(), cart.get_velocity(), mu);
+  }
+
+  static equinoctial_orbit from_keplerian(const keplerian_orbit& kep)
+  {
+    const double ecc = kep.get_e();
+    const double raan = kep.get_raan(false);
+    const double lon_periapsis = kep.get_aop(false) + raan;
+    const double tan_half_inc = std::tan(kep.get_i(false) / 2);
+    return {
+      kep.get_a() * (1 - ecc * ecc),
+      ecc * std::cos(lon_periapsis),
+      ecc * std::sin(lon_periapsis),
+      tan_half_inc * std::cos(raan),
+      tan_half_inc * std::sin(raan),
+      lon_periapsis + kep.get_true_anomaly()
+    };
+  }
+
+  [[nodiscard]] auto to_cartesian(const double mu = constants::EARTH_MU) const -> pv_state_type
+  {
+    const double cl = std::cos(m_l);
+    const double sl = std::sin(m_l);
+    const double w = 1 + m_f * cl + m_g * sl;
+    const double r = m_p / w;
+    const double s2 = 1 + m_h * m_h + m_k * m_k;
+    const double alpha2 = m_h * m_h - m_k * m_k;
+    const double hk = m_h * m_k;
+    const double sqrt_mu_p = std::sqrt(mu / m_p);
+
+    pv_state_type pv;
+    pv(0) = r / s2 * (cl + alpha2 * cl + 2 * hk * sl);
+    pv(1) = r / s2 * (sl - alpha2 * sl + 2 * hk * cl);
+    pv(2) = 2 * r / s2 * (m_h * sl - m_k * cl);
+    pv(3) = -sqrt_mu_p / s2 * (sl + alpha2 * sl - 2 * hk * cl + m_g - 2 * m_f * hk + alpha2 * m_g);
+    pv(4) = -sqrt_mu_p / s2 * (-cl + alpha2 * cl + 2 * hk * sl - m_f + 2 * m_g * hk + alpha2 * m_f);
+    pv(5) = 2 * sqrt_mu_p / s2 * (m_h * cl + m_k * sl + m_f * m_h + m_g * m_k);
+    return pv;
+  }
+
+  /**
+   * Circular orbits get aop = 0 and equatorial orbits raan = 0, as in
+   * `cartesian_to_keplerian`.
+   */
+  [[nodiscard]] auto to_keplerian() const -> keplerian_orbit
+  {
+    constexpr double two_pi = boost::math::double_constants::two_pi;
+    const double ecc = std::hypot(m_f, m_g);
+    const double tan_half_inc = std::hypot(m_h, m_k);
+    const double raan = tan_half_inc > 0 ? std::atan2(m_k, m_h) : 0.0;
+    const double lon_periapsis = ecc > 0 ? std::atan2(m_g, m_f) : raan;
+    auto wrap = [two_pi](const double angle) { return angle - two_pi * std::floor(angle / two_pi); };
+    return {
+      m_p / (1 - ecc * ecc),
+      ecc,
+      2 * std::atan(tan_half_inc),
+      wrap(raan),
+      wrap(lon_periapsis - raan),
+      wrap(m_l - lon_periapsis),
+      AnomalyType::TRUE
+    };
+  }
+
+  /**
+   * Gauss variational equations, the rates of the elements under a
+   * perturbing acceleration on top of the point mass gravity of `mu`.
+   *
+   * @param perturbation The perturbing acceleration in the radial,
+   * transverse, normal frame
+   * @param mu Gravitational parameter of the central body
+   * @return The rates of p, f, g, h, k, L
+   */
+  [[nodiscard]] auto get_derivative(const arma::vec3& perturbation, const double mu = constants::EARTH_MU) const -> pv_state_type
+  {
+    const double cl = std::cos(m_l);
+    const double sl = std::sin(m_l);
+    const double w = 1 + m_f * cl + m_g * sl;
+    const double s2 = 1 + m_h * m_h + m_k * m_k;
+    const double sqrt_p_mu = std::sqrt(m_p / mu);
+    const double hk_term = m_h * sl - m_k * cl;
+    const double dr = perturbation(0);
+    const double dt = perturbation(1);
+    const double dn = perturbation(2);
+
+    pv_state_type rates;
+    rates(0) = 2 * m_p / w * sqrt_p_mu * dt;
+    rates(1) = sqrt_p_mu * (dr * sl + ((w + 1) * cl + m_f) * dt / w - hk_term * m_g * dn / w);
+    rates(2) = sqrt_p_mu * (-dr * cl + ((w + 1) * sl + m_g) * dt / w + hk_term * m_f * dn / w);
+    rates(3) = sqrt_p_mu * s2 * cl * dn / (2 * w);
+    rates(4) = sqrt_p_mu * s2 * sl * dn / (2 * w);
+    rates(5) = std::sqrt(mu * m_p) * (w / m_p) * (w / m_p) + sqrt_p_mu * hk_term * dn / w;
+    return rates;
+  }
+
+  /**
+   * @return p, f, g, h, k, L
+   */
+  [[nodiscard]] auto to_vec() const -> pv_state_type
+  {
+    return {m_p, m_f, m_g, m_h, m_k, m_l};
+  }
+
+  [[nodiscard]] auto get_p() const -> double
+  {
+    return m_p;
+  }
+
+  [[nodiscard]] auto get_f() const -> double
+  {
+    return m_f;
+  }
+
+  [[nodiscard]] auto get_g() const -> double
+  {
+    return m_g;
+  }
+
+  [[nodiscard]] auto get_h() const -> double
+  {
+    return m_h;
+  }
+
+  [[nodiscard]] auto get_k() const -> double
+  {
+    return m_k;
+  }
+
+  [[nodiscard]] auto get_true_longitude() const -> double
+  {
+    return m_l;
+  }
+};
+
+/**
+ * Rotation of a vector from ECI into the radial, transverse, normal frame of
+ * the orbit through `r` with velocity `v`.
+ */
+inline arma::vec3 to_rtn(const arma::vec3& r, const arma::vec3& v, const arma::vec3& a)
+{
+  const arma::vec3 r_hat = arma::normalise(r);
+  const arma::vec3 n_hat = arma::normalise(arma::cross(r, v));
+  const arma::vec3 t_hat = arma::cross(n_hat, r_hat);
+  return {arma::dot(a, r_hat), arma::dot(a, t_hat), arma::dot(a, n_hat)};
+}
+}
+
+#endif //EQUINOCTIAL_H
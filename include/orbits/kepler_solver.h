@@ -0,0 +1,155 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef KEPLER_SOLVER_H
+#define KEPLER_SOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include <boost/math/constants/constants.hpp>
+
+namespace naomi::orbits
+{
+/**
+ * Halley iterations after the hyperbolic starter, enough to reach about 1e-15
+ * relative error.  Close to parabolic (e - 1 < 1e-2 with M < 1e-2) the
+ * equation itself is ill conditioned in double precision and the error grows
+ * to about 1e-11.
+ */
+constexpr int hyperbolic_kepler_iterations = 3;
+
+/**
+ * Eccentric anomaly from the mean anomaly, M = E - e sin(E), with Markley's
+ * starter and his fifth order correction (Markley 1995, "Kepler Equation
+ * Solver"), accurate to about 1e-15 for 0 <= e < 1 without further
+ * iterations.
+ *
+ * The function has no data dependent branches or iteration counts, so loops
+ * over arrays of it vectorise (sin/cos need a vector math library, e.g.
+ * glibc's libmvec with -O3 -ffast-math or -fopenmp-simd).
+ *
+ * @param e Eccentricity in [0, 1)
+ * @param mean_anomaly Mean anomaly in radians, any revolution
+ * @return The eccentric anomaly in the same revolution as the mean anomaly
+ */
+inline double solve_kepler_elliptic(const double e, const double mean_anomaly)
+{
+  constexpr double pi = boost::math::double_constants::pi;
+  constexpr double two_pi = boost::math::double_constants::two_pi;
+
+  // Solve for |M| in [0, pi], E - e sin(E) is odd and periodic
+  const double revolutions = two_pi * std::floor((mean_anomaly + pi) / two_pi);
+  const double reduced = mean_anomaly - revolutions;
+  const double m = std::abs(reduced);
+
+  const double alpha = (3 * pi * pi + 1.6 * pi * (pi - m) / (1 + e)) / (pi * pi - 6);
+  const double d = 3 * (1 - e) + alpha * e;
+  const double q = 2 * alpha * d * (1 - e) - m * m;
+  const double r = 3 * alpha * d * (d - 1 + e) * m + m * m * m;
+  const double s = std::abs(r) + std::sqrt(q * q * q + r * r);
+  const double w = std::cbrt(s * s);
+  const double e1 = (2 * r * w / (w * w + w * q + q * q) + m) / d;
+
+  const double f2 = e * std::sin(e1);
+  const double f3 = e * std::cos(e1);
+  const double f0 = e1 - f2 - m;
+  const double f1 = 1 - f3;
+  const double d3 = -f0 / (f1 - 0.5 * f0 * f2 / f1);
+  const double d4 = -f0 / (f1 + 0.5 * d3 * f2 + d3 * d3 * f3 / 6);
+  const double d5 = -f0 / (f1 + 0.5 * d4 * f2 + d4 * d4 * f3 / 6 - d4 * d4 * d4 * f2 / 24);
+
+  return std::copysign(e1 + d5, reduced) + revolutions;
+}
+
+/**
+ * Hyperbolic anomaly from the mean anomaly, M = e sinh(H) - H, with a fixed
+ * number of Halley iterations.  The starter is the better, by residual, of
+ * the root of the cubic expansion (bounded by asinh(M / (e - 1))), which is
+ * close for small H, and one fixed point step of H = asinh((M + H) / e) from
+ * Danby's logarithmic guess, which is close for large H.  Branch free like
+ * `solve_kepler_elliptic`.
+ *
+ * @param e Eccentricity, greater than 1
+ * @param mean_anomaly Hyperbolic mean anomaly
+ * @return The hyperbolic anomaly
+ */
+inline double solve_kepler_hyperbolic(const double e, const double mean_anomaly)
+{
+  const double m = std::abs(mean_anomaly);
+
+  // e H^3 / 6 + (e - 1) H = M, Cardano for the single real root
+  const double a = 6 * (e - 1) / e;
+  const double b = 6 * m / e;
+  const double disc = std::sqrt(0.25 * b * b + a * a * a / 27);
+  const double cubic = std::min(std::cbrt(0.5 * b + disc) + std::cbrt(0.5 * b - disc), std::asinh(m / (e - 1)));
+  const double logarithmic = std::asinh((m + std::log(2 * m / e + 1.8)) / e);
+  const double cubic_residual = std::abs(e * std::sinh(cubic) - cubic - m);
+  const double logarithmic_residual = std::abs(e * std::sinh(logarithmic) - logarithmic - m);
+  double h = logarithmic_residual < cubic_residual ? logarithmic : cubic;
+
+  for (int i = 0; i < hyperbolic_kepler_iterations; i++) {
+    const double f2 = e * std::sinh(h);
+    const double f0 = f2 - h - m;
+    const double f1 = e * std::cosh(h) - 1;
+    h -= f0 / (f1 - 0.5 * f0 * f2 / f1);
+  }
+  return std::copysign(h, mean_anomaly);
+}
+
+/**
+ * Batch `solve_kepler_elliptic` over structure of arrays input, written as a
+ * plain loop over contiguous memory so the compiler can vectorise it.
+ *
+ * @param e Eccentricities
+ * @param mean_anomaly Mean anomalies
+ * @param eccentric_anomaly Output, may alias `mean_anomaly`
+ * @param n Number of orbits
+ */
+inline void solve_kepler_elliptic(const double* e, const double* mean_anomaly, double* eccentric_anomaly, const std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    eccentric_anomaly[i] = solve_kepler_elliptic(e[i], mean_anomaly[i]);
+  }
+}
+
+/**
+ * Batch `solve_kepler_hyperbolic`, see the elliptic batch solver.
+ */
+inline void solve_kepler_hyperbolic(const double* e, const double* mean_anomaly, double* hyperbolic_anomaly, const std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    hyperbolic_anomaly[i] = solve_kepler_hyperbolic(e[i], mean_anomaly[i]);
+  }
+}
+
+inline arma::vec solve_kepler_elliptic(const arma::vec& e, const arma::vec& mean_anomaly)
+{
+  if (e.n_elem != mean_anomaly.n_elem) {
+    throw std::runtime_error(fmt::format(
+        "Got {} eccentricities and {} mean anomalies", e.n_elem, mean_anomaly.n_elem));
+  }
+  arma::vec eccentric_anomaly(e.n_elem);
+  solve_kepler_elliptic(e.memptr(), mean_anomaly.memptr(), eccentric_anomaly.memptr(), e.n_elem);
+  return eccentric_anomaly;
+}
+
+inline arma::vec solve_kepler_hyperbolic(const arma::vec& e, const arma::vec& mean_anomaly)
+{
+  if (e.n_elem != mean_anomaly.n_elem) {
+    throw std::runtime_error(fmt::format(
+        "Got {} eccentricities and {} mean anomalies", e.n_elem, mean_anomaly.n_elem));
+  }
+  arma::vec hyperbolic_anomaly(e.n_elem);
+  solve_kepler_hyperbolic(e.memptr(), mean_anomaly.memptr(), hyperbolic_anomaly.memptr(), e.n_elem);
+  return hyperbolic_anomaly;
+}
+}
+
+#endif //KEPLER_SOLVER_H
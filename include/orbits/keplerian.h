@@ -13,6 +13,8 @@
 #include <boost/math/tools/tuple.hpp>
 #include <boost/math/tools/roots.hpp>
 #include "integrators/integrator.h"
+#include "orbits/kepler_solver.h"
+#include "orbits/orbit_batch.h"
 
 namespace naomi::orbits
 {
@@ -115,27 +117,9 @@ public:
 
   static double compute_eccentricity(arma::vec3& r, arma::vec3& v, double mu)
   {
-    typedef arma::vec3 t;
-
-    auto rn = norm(r, 2);
-    auto vn =  norm(v, 2);
-    auto v_r = dot(r/rn, v);
-    fmt::print("rn = {}\nvn = {}\nv_r = {}\n\n", rn, vn, v_r);
-
-    t h = cross(r, v);
-    h.print("h = ");
-    auto hn = norm(h);
-    fmt::print("hn = {}\n\n", hn);
-    t vxh = cross(v, h);
-    t vxh_mu = vxh / mu;
-    t norm_r = r / rn;
-    vxh.print("vxh = ");
-    vxh_mu.print("vxh_mu = ");
-    norm_r.print("norm_r = ");
-    t e = vxh_mu - norm_r;
-    e.print("e = ");
-    double en = norm(e, 2);
-    return en;
+    const arma::vec3 h = cross(r, v);
+    const arma::vec3 e = cross(v, h) / mu - r / norm(r, 2);
+    return norm(e, 2);
   }
 
   auto to_cartesian() const -> arma::vec6
@@ -145,27 +129,9 @@ public:
     auto p = m_sma * (1 - pow(m_ecc, 2));
     auto r = p / (1 + m_ecc*cos(th));
     auto h = sqrt(p * constants::EARTH_MU);
-    arma::vec3 r_peri = {r * cos(th), r*sin(th), 0};
-    arma::vec3 v_peri = {-(constants::EARTH_MU/h) * sin(th), (constants::EARTH_MU/h)*(m_ecc + cos(th)), 0};
-    arma::mat a = {
-      {cos(m_aop), sin(m_aop), 0},
-      {-sin(m_aop), cos(m_aop), 0},
-      {0, 0, 1}
-    };
-    arma::mat b = {
-      { 1, 0, 0},
-        {0, cos(m_inc), sin(m_inc)},
-        {0, -sin(m_inc), cos(m_inc)},
-    };
-    arma::mat c = {
-      {cos(m_raan), sin(m_raan), 0},
-      {-sin(m_raan), cos(m_raan), 0},
-      {0, 0, 1}
-    };
-    auto o_pg = (a * b * c).eval();
-    auto o_gp = o_pg.t().eval();
-    arma::vec3 r_eci = o_gp * r_peri;
-    arma::vec3 v_eci = o_gp * v_peri;
+    const auto [p_axis, q_axis] = perifocal_axes(m_inc, m_raan, m_aop);
+    arma::vec3 r_eci = r * cos(th) * p_axis + r * sin(th) * q_axis;
+    arma::vec3 v_eci = -(constants::EARTH_MU/h) * sin(th) * p_axis + (constants::EARTH_MU/h) * (m_ecc + cos(th)) * q_axis;
     return arma::join_cols(r_eci, v_eci);
   }
 
@@ -224,15 +190,23 @@ public:
   [[nodiscard]] auto get_eccentric_anomaly() const -> double
   {
     if (m_anomaly_type == AnomalyType::MEAN) {
-      int digits = std::numeric_limits<double>::digits; // Maximum possible binary digits accuracy for type T.
-      return boost::math::tools::newton_raphson_iterate(eccentric_anomaly_functor<double>(m_ecc, m_anomaly), 0.1, -2*boost::math::double_constants::pi, 2*boost::math::double_constants::pi, digits);
+      return solve_kepler_elliptic(m_ecc, m_anomaly);
     }
     if (m_anomaly_type == AnomalyType::TRUE) {
       auto tan_psi = sqrt((1 - m_ecc ) / (1 + m_ecc))  * tan(m_anomaly/2);
       auto psi = atan(tan_psi) * 2;
       return psi;
     }
-    return 0.0;
+    return m_anomaly;
+  }
+
+  [[nodiscard]] auto get_true_anomaly() const -> double
+  {
+    if (m_anomaly_type == AnomalyType::TRUE) {
+      return m_anomaly;
+    }
+    const double psi = get_eccentric_anomaly();
+    return 2 * atan2(sqrt(1 + m_ecc) * sin(psi / 2), sqrt(1 - m_ecc) * cos(psi / 2));
   }
 
   double rad2deg(double rad) const
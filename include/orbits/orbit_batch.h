@@ -0,0 +1,267 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ORBIT_BATCH_H
+#define ORBIT_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "constants.h"
+#include "orbits/kepler_solver.h"
+
+namespace naomi::orbits
+{
+/**
+ * Cartesian states of many orbits, one array per component.
+ */
+struct cartesian_batch
+{
+  std::vector<double> x, y, z;
+  std::vector<double> vx, vy, vz;
+
+  cartesian_batch() = default;
+  explicit cartesian_batch(const std::size_t n): x(n), y(n), z(n), vx(n), vy(n), vz(n){}
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return x.size();
+  }
+
+  void check_sizes() const
+  {
+    const std::size_t n = size();
+    if (y.size() != n || z.size() != n || vx.size() != n || vy.size() != n || vz.size() != n) {
+      throw std::runtime_error("Cartesian batch components differ in size");
+    }
+  }
+};
+
+/**
+ * Keplerian elements of many orbits, one array per element.  Angles are in
+ * radians and the anomaly is the mean anomaly.  Hyperbolic orbits have
+ * e > 1 and a negative semi-major axis.
+ *
+ * Singular orbits follow one convention in both directions: equatorial
+ * orbits have raan = 0 (the node line is the x axis), circular orbits have
+ * aop = 0 (the anomaly is measured from the node line), so circular
+ * equatorial orbits carry the true longitude in the mean anomaly.
+ */
+struct keplerian_batch
+{
+  std::vector<double> sma, ecc, inc, raan, aop, ma;
+
+  keplerian_batch() = default;
+  explicit keplerian_batch(const std::size_t n): sma(n), ecc(n), inc(n), raan(n), aop(n), ma(n){}
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return sma.size();
+  }
+
+  void check_sizes() const
+  {
+    const std::size_t n = size();
+    if (ecc.size() != n || inc.size() != n || raan.size() != n || aop.size() != n || ma.size() != n) {
+      throw std::runtime_error("Keplerian batch elements differ in size");
+    }
+  }
+};
+
+/// Eccentricity and sin(inclination) below which an orbit is treated as
+/// circular or equatorial
+constexpr double singular_orbit_tolerance = 1e-11;
+
+/// Batches at least this large are split across the hardware threads
+constexpr std::size_t parallel_batch_threshold = 1 << 14;
+
+/**
+ * Calls `kernel(begin, end)` on contiguous chunks of [0, n), on all hardware
+ * threads once n reaches `parallel_batch_threshold`.
+ */
+template <typename Kernel>
+void for_each_chunk(const std::size_t n, const Kernel& kernel)
+{
+  const std::size_t n_workers = n < parallel_batch_threshold
+      ? 1
+      : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  if (n_workers == 1) {
+    kernel(std::size_t{0}, n);
+    return;
+  }
+  const std::size_t chunk = (n + n_workers - 1) / n_workers;
+  std::vector<std::future<void>> futures;
+  for (std::size_t begin = chunk; begin < n; begin += chunk) {
+    futures.push_back(std::async(std::launch::async, [&kernel, begin, end = std::min(n, begin + chunk)]
+    {
+      kernel(begin, end);
+    }));
+  }
+  kernel(std::size_t{0}, std::min(n, chunk));
+  for (auto& future: futures) {
+    future.get();
+  }
+}
+
+/**
+ * Perifocal P (periapsis) and Q axes in ECI, the first two columns of
+ * R3(-raan) R1(-inc) R3(-aop) in closed form.
+ */
+inline std::pair<arma::vec3, arma::vec3> perifocal_axes(const double inc, const double raan, const double aop)
+{
+  const double co = std::cos(raan), so = std::sin(raan);
+  const double ci = std::cos(inc), si = std::sin(inc);
+  const double cw = std::cos(aop), sw = std::sin(aop);
+  return {
+    {co * cw - so * sw * ci, so * cw + co * sw * ci, sw * si},
+    {-co * sw - so * cw * ci, -so * sw + co * cw * ci, cw * si}
+  };
+}
+
+/**
+ * Keplerian elements (mean anomaly) to Cartesian position and velocity of a
+ * single orbit, the kernel of `keplerian_to_cartesian`.
+ */
+inline arma::vec6 keplerian_to_cartesian(const double sma, const double ecc, const double inc, const double raan,
+                                         const double aop, const double ma, const double mu = constants::EARTH_MU)
+{
+  double true_anomaly;
+  double r;
+  if (ecc < 1) {
+    const double ea = solve_kepler_elliptic(ecc, ma);
+    true_anomaly = 2 * std::atan2(std::sqrt(1 + ecc) * std::sin(ea / 2), std::sqrt(1 - ecc) * std::cos(ea / 2));
+    r = sma * (1 - ecc * std::cos(ea));
+  } else {
+    const double ha = solve_kepler_hyperbolic(ecc, ma);
+    true_anomaly = 2 * std::atan2(std::sqrt(ecc + 1) * std::sinh(ha / 2), std::sqrt(ecc - 1) * std::cosh(ha / 2));
+    r = sma * (1 - ecc * std::cosh(ha));
+  }
+  const double p = sma * (1 - ecc * ecc);
+  const double v_scale = std::sqrt(mu / p);
+  const double cv = std::cos(true_anomaly), sv = std::sin(true_anomaly);
+
+  const auto [p_axis, q_axis] = perifocal_axes(inc, raan, aop);
+  arma::vec6 pv;
+  pv.subvec(0, 2) = r * cv * p_axis + r * sv * q_axis;
+  pv.subvec(3, 5) = v_scale * (-sv * p_axis + (ecc + cv) * q_axis);
+  return pv;
+}
+
+/**
+ * Cartesian position and velocity to Keplerian elements (mean anomaly) of a
+ * single orbit, the kernel of `cartesian_to_keplerian`.  Parabolic orbits
+ * aren't representable and give an infinite semi-major axis.
+ *
+ * @return sma, ecc, inc, raan, aop, ma
+ */
+inline arma::vec6 cartesian_to_keplerian(const arma::vec3& r, const arma::vec3& v, const double mu = constants::EARTH_MU)
+{
+  constexpr double two_pi = boost::math::double_constants::two_pi;
+
+  const double rn = arma::norm(r);
+  const double v2 = arma::dot(v, v);
+  const arma::vec3 h = arma::cross(r, v);
+  const double hn = arma::norm(h);
+  const arma::vec3 h_hat = h / hn;
+  const arma::vec3 e_vec = ((v2 - mu / rn) * r - arma::dot(r, v) * v) / mu;
+  const double ecc = arma::norm(e_vec);
+  const double sma = -mu / (2 * (v2 / 2 - mu / rn));
+  const double inc = std::atan2(std::hypot(h_hat(0), h_hat(1)), h_hat(2));
+
+  // Node line, the x axis for equatorial orbits
+  const arma::vec3 node = {-h_hat(1), h_hat(0), 0};
+  const double node_norm = arma::norm(node);
+  const bool equatorial = node_norm < singular_orbit_tolerance;
+  const arma::vec3 node_hat = equatorial ? arma::vec3{1, 0, 0} : arma::vec3(node / node_norm);
+  const double raan = equatorial ? 0.0 : std::atan2(node_hat(1), node_hat(0));
+
+  // Periapsis direction, the node line for circular orbits
+  const bool circular = ecc < singular_orbit_tolerance;
+  const arma::vec3 periapsis_hat = circular ? node_hat : arma::vec3(e_vec / ecc);
+  const double aop = circular ? 0.0
+      : std::atan2(arma::dot(arma::cross(node_hat, periapsis_hat), h_hat), arma::dot(node_hat, periapsis_hat));
+  const double true_anomaly = std::atan2(arma::dot(arma::cross(periapsis_hat, r), h_hat), arma::dot(periapsis_hat, r));
+
+  const double e = circular ? 0.0 : ecc;
+  double ma;
+  if (e < 1) {
+    const double ea = std::atan2(std::sqrt(1 - e * e) * std::sin(true_anomaly), e + std::cos(true_anomaly));
+    ma = ea - e * std::sin(ea);
+    ma -= two_pi * std::floor(ma / two_pi);
+  } else {
+    const double ha = 2 * std::atanh(std::sqrt((e - 1) / (e + 1)) * std::tan(true_anomaly / 2));
+    ma = e * std::sinh(ha) - ha;
+  }
+  const double wrapped_raan = raan - two_pi * std::floor(raan / two_pi);
+  const double wrapped_aop = aop - two_pi * std::floor(aop / two_pi);
+  return {sma, e, inc, wrapped_raan, wrapped_aop, ma};
+}
+
+/**
+ * Batch Keplerian to Cartesian conversion.
+ *
+ * @param elements The elements of every orbit
+ * @param mu Gravitational parameter of the central body
+ * @return The Cartesian states, in the order of `elements`
+ */
+inline cartesian_batch keplerian_to_cartesian(const keplerian_batch& elements, const double mu = constants::EARTH_MU)
+{
+  elements.check_sizes();
+  cartesian_batch states(elements.size());
+  for_each_chunk(elements.size(), [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; i++) {
+      const arma::vec6 pv = keplerian_to_cartesian(elements.sma[i], elements.ecc[i], elements.inc[i],
+                                                   elements.raan[i], elements.aop[i], elements.ma[i], mu);
+      states.x[i] = pv(0);
+      states.y[i] = pv(1);
+      states.z[i] = pv(2);
+      states.vx[i] = pv(3);
+      states.vy[i] = pv(4);
+      states.vz[i] = pv(5);
+    }
+  });
+  return states;
+}
+
+/**
+ * Batch Cartesian to Keplerian conversion.
+ *
+ * @param states The Cartesian states of every orbit
+ * @param mu Gravitational parameter of the central body
+ * @return The elements, in the order of `states`
+ */
+inline keplerian_batch cartesian_to_keplerian(const cartesian_batch& states, const double mu = constants::EARTH_MU)
+{
+  states.check_sizes();
+  keplerian_batch elements(states.size());
+  for_each_chunk(states.size(), [&](const std::size_t begin, const std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; i++) {
+      const arma::vec6 kep = cartesian_to_keplerian({states.x[i], states.y[i], states.z[i]},
+                                                    {states.vx[i], states.vy[i], states.vz[i]}, mu);
+      elements.sma[i] = kep(0);
+      elements.ecc[i] = kep(1);
+      elements.inc[i] = kep(2);
+      elements.raan[i] = kep(3);
+      elements.aop[i] = kep(4);
+      elements.ma[i] = kep(5);
+    }
+  });
+  return elements;
+}
+}
+
+#endif //ORBIT_BATCH_H
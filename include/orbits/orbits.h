@@ -4,6 +4,9 @@
 
 #ifndef ORBITS_H
 #define ORBITS_H
+#include <algorithm>
+#include <cmath>
+
 #include <armadillo>
 
 #include "constants.h"
@@ -36,5 +39,91 @@ inline vector_type get_circular_orbit(const arma::vec3& initial_position, const
 {
   return sqrt(mu * (2/radius - 1/sma));
 }
+
+/**
+ * Stumpff function C(z) = (1 - cos(sqrt(z))) / z, continued to z <= 0
+ *
+ * @param z Universal variable argument, alpha * chi^2
+ * @return The value of C(z)
+ */
+[[nodiscard]] inline double stumpff_c(const double z)
+{
+  if (std::abs(z) < 1e-2) {
+    return 1.0/2 - z/24 + z*z/720 - z*z*z/40320 + z*z*z*z/3628800;
+  }
+  if (z > 0) {
+    return (1 - cos(sqrt(z))) / z;
+  }
+  return (cosh(sqrt(-z)) - 1) / -z;
+}
+
+/**
+ * Stumpff function S(z) = (sqrt(z) - sin(sqrt(z))) / sqrt(z)^3, continued to
+ * z <= 0
+ *
+ * @param z Universal variable argument, alpha * chi^2
+ * @return The value of S(z)
+ */
+[[nodiscard]] inline double stumpff_s(const double z)
+{
+  if (std::abs(z) < 1e-2) {
+    return 1.0/6 - z/120 + z*z/5040 - z*z*z/362880 + z*z*z*z/39916800;
+  }
+  if (z > 0) {
+    const double sz = sqrt(z);
+    return (sz - sin(sz)) / (sz*sz*sz);
+  }
+  const double sz = sqrt(-z);
+  return (sinh(sz) - sz) / (sz*sz*sz);
+}
+
+/**
+ * Propagate a state along its two-body conic with the universal variable
+ * formulation of Kepler's equation, valid for elliptic, parabolic and
+ * hyperbolic orbits.
+ *
+ * @param r0 Initial position in meters
+ * @param v0 Initial velocity in meters per second
+ * @param dt Time of flight in seconds, may be negative
+ * @param mu Optional gravitational parameter for the central body, defaults to
+ * the gravitational parameter for Earth
+ * @return The position and velocity after dt
+ */
+[[nodiscard]] inline pv_state_type kepler_propagate(const arma::vec3& r0,
+                                                    const arma::vec3& v0,
+                                                    const double dt,
+                                                    const double mu = constants::EARTH_MU)
+{
+  const double r0n = norm(r0);
+  const double sqrt_mu = sqrt(mu);
+  const double sigma = dot(r0, v0) / sqrt_mu;
+  const double alpha = 2 / r0n - dot(v0, v0) / mu;
+
+  double chi = alpha > 0 ? sqrt_mu * alpha * dt : sqrt_mu * dt / r0n;
+  for (int i = 0; i < 50; i++) {
+    const double z = alpha * chi * chi;
+    const double c = stumpff_c(z);
+    const double s = stumpff_s(z);
+    const double f = sigma*chi*chi*c + (1 - alpha*r0n)*chi*chi*chi*s + r0n*chi - sqrt_mu*dt;
+    const double df = sigma*chi*(1 - z*s) + (1 - alpha*r0n)*chi*chi*c + r0n;
+    const double delta = f / df;
+    chi -= delta;
+    if (std::abs(delta) <= 1e-14 * std::max(1.0, std::abs(chi))) {
+      break;
+    }
+  }
+
+  const double z = alpha * chi * chi;
+  const double c = stumpff_c(z);
+  const double s = stumpff_s(z);
+  const double f = 1 - chi*chi/r0n * c;
+  const double g = dt - chi*chi*chi/sqrt_mu * s;
+  const arma::vec3 r = f*r0 + g*v0;
+  const double rn = norm(r);
+  const double f_dot = sqrt_mu / (rn*r0n) * (alpha*chi*chi*chi*s - chi);
+  const double g_dot = 1 - chi*chi/rn * c;
+  const arma::vec3 v = f_dot*r0 + g_dot*v0;
+  return join_cols(r, v);
+}
 }
 #endif //ORBITS_H
@@ -0,0 +1,84 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Heap allocations are only counted in targets built with
+ * NAOMI_COUNT_ALLOCATIONS=1 that link src/allocation_hooks.cpp, which
+ * replaces the global operator new and delete (CMake option
+ * NAOMI_COUNT_ALLOCATIONS, test and benchmark targets only).  Otherwise all
+ * counts stay zero.
+ */
+#ifndef NAOMI_COUNT_ALLOCATIONS
+#define NAOMI_COUNT_ALLOCATIONS 0
+#endif
+
+namespace naomi::profiling
+{
+inline constexpr bool allocation_counting_enabled = NAOMI_COUNT_ALLOCATIONS;
+
+struct allocation_counts
+{
+  std::uint64_t allocations = 0;
+  std::uint64_t deallocations = 0;
+  /// Bytes requested by the allocations
+  std::uint64_t bytes = 0;
+
+  allocation_counts operator-(const allocation_counts& other) const
+  {
+    return {allocations - other.allocations, deallocations - other.deallocations, bytes - other.bytes};
+  }
+};
+
+namespace detail
+{
+/// Counts of the calling thread, updated by the operator new/delete hooks.
+/// Constant initialized so the hooks may touch it at any time.
+inline thread_local allocation_counts thread_counts;
+}
+
+/**
+ * @return The allocations of the calling thread since it started
+ */
+inline allocation_counts get_thread_allocations()
+{
+  return detail::thread_counts;
+}
+
+/**
+ * Counts the heap allocations of the calling thread from its construction,
+ * e.g. around a benchmark loop or in a regression test:
+ *
+ *     allocation_scope scope;
+ *     eoms.get_derivative(x, 0.0);
+ *     EXPECT_LE(scope.get().allocations, 2);
+ *
+ * Allocations made by other threads (e.g. worker pools) aren't included.
+ */
+class allocation_scope
+{
+  allocation_counts m_start = get_thread_allocations();
+
+public:
+  /**
+   * @return The allocations since construction or the last `reset`
+   */
+  [[nodiscard]] allocation_counts get() const
+  {
+    return get_thread_allocations() - m_start;
+  }
+
+  void reset()
+  {
+    m_start = get_thread_allocations();
+  }
+};
+}
+
+#endif //ALLOCATION_COUNTER_H
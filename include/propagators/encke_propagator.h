@@ -0,0 +1,284 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef ENCKE_PROPAGATOR_H
+#define ENCKE_PROPAGATOR_H
+
+#include <cmath>
+
+#include <armadillo>
+
+#include "integrators/integrator.h"
+#include "integrators/odeint_armadillo.h"
+#include "constants.h"
+#include "orbits/orbits.h"
+#include "propagators/event_detector.h"
+#include "propagators/event_locator.h"
+#include "simulation/tracing.h"
+#include "spacecraft/spacecraft.h"
+
+namespace naomi::numeric
+{
+using namespace events;
+using namespace maneuvers;
+
+/**
+ * Osculating two-body conic a spacecraft's deviation is measured from, given
+ * by its Cartesian state at the epoch of the last rectification.
+ */
+struct encke_reference
+{
+  arma::vec3 position;
+  arma::vec3 velocity;
+  double epoch;
+
+  [[nodiscard]] pv_state_type at(const double t, const double mu) const
+  {
+    return orbits::kepler_propagate(position, velocity, t - epoch, mu);
+  }
+};
+
+/**
+ * Encke's method: only the deviation of each spacecraft from an osculating
+ * Kepler conic is integrated, the conic itself is evaluated analytically.
+ *
+ * The deviation is driven by the difference of the central terms, in Battin's
+ * form (mu / r^3) (f(q) rho - delta) which avoids the cancellation of two
+ * nearly equal accelerations, plus the non-central part of the force model
+ * (the configured `equations_of_motion` minus the point mass term).  Since the
+ * deviation changes slowly the stepper can take much larger steps than when
+ * integrating the full state.  The reference is rectified to the current
+ * osculating orbit once the deviation exceeds a fraction of the distance, and
+ * after every event since maneuvers change the orbit discontinuously.
+ *
+ * The interface matches `numerical_propagator`, spacecraft and event detectors
+ * only ever see the full Cartesian integrated state.
+ *
+ * @tparam Stepper The stepper used for the deviation (see boost docs)
+ */
+template <typename Stepper>
+class encke_propagator
+{
+  integrator<Stepper> m_integrator;
+  std::shared_ptr<equations_of_motion> _system_eoms;
+  std::map<std::string, std::shared_ptr<spacecraft>> m_spacecrafts;
+  std::map<std::string, encke_reference> m_references;
+  event_locator m_events;
+  double m_mu = constants::EARTH_MU;
+  double m_rectify_ratio = 1e-2;
+  std::size_t m_rectifications = 0;
+  double m_t = 0.0;
+
+  /**
+   * Deviation dynamics, the state is the integrated state of the spacecraft
+   * with position and velocity replaced by their deviation from `reference`.
+   */
+  auto make_system(const std::shared_ptr<spacecraft>& spacecraft, const encke_reference& reference)
+  {
+    auto system_eoms = _system_eoms;
+    const auto provider_map = spacecraft->get_state().get_provider_mapping();
+    const double mu = m_mu;
+    return [system_eoms, provider_map, reference, mu](const vector_type& y, vector_type& dydt, double t)
+        {
+          const pv_state_type conic = reference.at(t, mu);
+          vector_type x = y;
+          x.subvec(0, 5) += conic;
+
+          vector_type dxdt(x.n_elem);
+          for (const auto& [fst, snd] : provider_map) {
+            if (auto eoms = snd->get_eoms(); eoms == nullptr) {
+              dxdt(fst) = system_eoms->get_derivative(x(fst), t);
+            } else {
+              dxdt(fst) = eoms->get_derivative(x(fst), t);
+            }
+          }
+
+          const arma::vec3 r = x.subvec(0, 2);
+          const arma::vec3 rho = conic.subvec(0, 2);
+          const arma::vec3 delta = y.subvec(0, 2);
+          const double rn = arma::norm(r);
+          const double mu_r3 = mu / (rn * rn * rn);
+          const arma::vec3 perturbation = dxdt.subvec(3, 5) + mu_r3 * r;
+          const double q = arma::dot(delta, 2 * rho + delta) / arma::dot(rho, rho);
+          const double f = q * (3 + 3 * q + q * q) / (1 + std::pow(1 + q, 1.5));
+
+          dydt = dxdt;
+          dydt(arma::span(0, 2)) = y.subvec(3, 5);
+          dydt(arma::span(3, 5)) = mu_r3 * (f * rho - delta) + perturbation;
+        };
+  }
+
+  [[nodiscard]] vector_type to_cartesian(const vector_type& y, const double t, const encke_reference& reference) const
+  {
+    vector_type x = y;
+    x.subvec(0, 5) += reference.at(t, m_mu);
+    return x;
+  }
+
+  [[nodiscard]] vector_type to_deviation(const vector_type& x, const double t, const encke_reference& reference) const
+  {
+    vector_type y = x;
+    y.subvec(0, 5) -= reference.at(t, m_mu);
+    return y;
+  }
+
+  encke_reference rectify(const vector_type& x, const double t)
+  {
+    m_rectifications++;
+    m_integrator.reset();
+    return {x.subvec(0, 2), x.subvec(3, 5), t};
+  }
+
+  [[nodiscard]] bool needs_rectification(const vector_type& y, const double t, const encke_reference& reference) const
+  {
+    return arma::norm(y.subvec(0, 2)) > m_rectify_ratio * arma::norm(reference.at(t, m_mu).subvec(0, 2));
+  }
+
+public:
+  ~encke_propagator() = default;
+  encke_propagator() = default;
+
+  /**
+   * @param stepper The stepper used for the deviation
+   * @param abs_tol Absolute error tolerance of the stepper
+   * @param rel_tol Relative error tolerance of the stepper
+   * @param mu Gravitational parameter of the central body of the reference
+   * conic
+   * @param rectify_ratio Rectify once |delta| / |rho| exceeds this ratio
+   */
+  explicit encke_propagator(Stepper stepper,
+                            const double abs_tol = 1e-6,
+                            const double rel_tol = 1e-6,
+                            const double mu = constants::EARTH_MU,
+                            const double rectify_ratio = 1e-2)
+      : m_integrator(std::move(stepper), abs_tol, rel_tol), m_mu(mu), m_rectify_ratio(rectify_ratio)
+  {
+  }
+
+  void initialize(const std::shared_ptr<equations_of_motion>& system_eoms, const std::map<std::string, std::shared_ptr<spacecraft>>& spacecrafts)
+  {
+    _system_eoms = system_eoms;
+    m_spacecrafts = spacecrafts;
+    for (const auto & [fst, sc] : m_spacecrafts) {
+      if (sc->get_maneuver_plan() != nullptr) m_events.add(sc->get_maneuver_plan());
+    }
+  }
+
+  /**
+   * Detect events of `detector` in addition to the maneuver plans of the
+   * spacecraft.
+   */
+  void add_event_detector(const std::shared_ptr<event_detector>& detector)
+  {
+    m_events.add(detector);
+  }
+
+  /**
+   * @return The number of times a reference conic was (re)initialized
+   */
+  [[nodiscard]] std::size_t get_rectification_count() const
+  {
+    return m_rectifications;
+  }
+
+  /**
+   * Integrate the spacecraft to `end_time`.  Like `numerical_propagator`,
+   * integration stops exactly on the times of the scheduled events and on the
+   * earliest state dependent event within each accepted step, the detectors
+   * are sampled on the full Cartesian state.  Integration also stops at the
+   * end of the step after which the reference needs rectification.
+   */
+  void propagate_to(const std::shared_ptr<spacecraft>& spacecraft, const double end_time)
+  {
+    NAOMI_TRACE_SCOPE("propagate_to", spacecraft->get_identifier());
+    double t = m_t;
+    vector_type x = spacecraft->get_state().get_integrated_state();
+    auto reference_it = m_references.find(spacecraft->get_identifier());
+    if (reference_it == m_references.end()) {
+      reference_it = m_references.emplace(spacecraft->get_identifier(), rectify(x, t)).first;
+    }
+    encke_reference& reference = reference_it->second;
+
+    vector_type y = to_deviation(x, t, reference);
+    if (needs_rectification(y, t, reference)) {
+      reference = rectify(x, t);
+      y = to_deviation(x, t, reference);
+    }
+    event_locator::event_queue scheduled = m_events.schedule_all(spacecraft->get_identifier(), t, end_time);
+
+    auto handle_event = [&](const std::shared_ptr<event_detector>& e)
+    {
+      m_events.record_event(spacecraft->get_identifier(), e, t);
+      spacecraft->get_state().set_integrated_state(to_cartesian(y, t, reference));
+      e->handle_event(spacecraft, t);
+      spacecraft->update(t);
+      // Maneuvers change the orbit discontinuously
+      x = spacecraft->get_state().get_integrated_state();
+      reference = rectify(x, t);
+      y = to_deviation(x, t, reference);
+      m_events.schedule(scheduled, spacecraft->get_identifier(), e, t, end_time);
+    };
+
+    while (true) {
+      while (const auto due = m_events.pop_due(scheduled, spacecraft->get_identifier(), t)) {
+        handle_event(due);
+      }
+      if (t >= end_time) {
+        break;
+      }
+
+      const double boundary = event_locator::next_boundary(scheduled, end_time);
+      const system_t system = make_system(spacecraft, reference);
+      std::shared_ptr<event_detector> triggered;
+      bool rectification_due = false;
+      t = m_integrator.integrate_steps(system, y, t, boundary, 0.1,
+          [this, &reference, &triggered, &rectification_due](const double step_start, const double step_end, const step_interpolator_t& interpolate)
+          {
+            auto [event_time, detector] = m_events.find_first_event(step_start, step_end,
+                [this, &reference, &interpolate](const double time)
+                {
+                  return state_and_time_type(to_cartesian(interpolate(time), time, reference), time);
+                });
+            triggered = detector;
+            if (detector != nullptr) {
+              return std::optional<double>(event_time);
+            }
+            rectification_due = needs_rectification(interpolate(step_end), step_end, reference);
+            return rectification_due ? std::optional<double>(step_end) : std::optional<double>();
+          });
+      if (triggered != nullptr) {
+        handle_event(triggered);
+      } else if (rectification_due) {
+        x = to_cartesian(y, t, reference);
+        reference = rectify(x, t);
+        y = to_deviation(x, t, reference);
+      }
+    }
+
+    spacecraft->get_state().set_integrated_state(to_cartesian(y, end_time, reference));
+    spacecraft->update(end_time);
+  }
+
+  double propagate_to(const double t)
+  {
+    for (const auto & [scid, sc]: m_spacecrafts) {
+      propagate_to(sc, t);
+    }
+    m_t = t;
+    return m_t;
+  }
+
+  void propagate_by(const std::shared_ptr<spacecraft>& spacecraft, double dt)
+  {
+    propagate_to(spacecraft, m_t + dt);
+  }
+
+  double propagate_by(const double dt)
+  {
+    return propagate_to(m_t + dt);
+  }
+};
+}
+
+#endif //ENCKE_PROPAGATOR_H
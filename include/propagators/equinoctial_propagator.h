@@ -0,0 +1,211 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef EQUINOCTIAL_PROPAGATOR_H
+#define EQUINOCTIAL_PROPAGATOR_H
+
+#include <cmath>
+
+#include <armadillo>
+
+#include "integrators/integrator.h"
+#include "integrators/odeint_armadillo.h"
+#include "constants.h"
+#include "orbits/equinoctial.h"
+#include "propagators/event_detector.h"
+#include "propagators/event_locator.h"
+#include "simulation/tracing.h"
+#include "spacecraft/spacecraft.h"
+
+namespace naomi::numeric
+{
+using namespace events;
+using namespace maneuvers;
+
+/**
+ * Propagator integrating the orbit in modified equinoctial elements with the
+ * Gauss variational equations (see `orbits::equinoctial_orbit`).
+ *
+ * Without perturbations five of the elements are constant and the true
+ * longitude advances smoothly, so the perturbations (the configured
+ * `equations_of_motion` minus the point mass term of `mu`) only enter as slow
+ * rates and the stepper can take much larger steps than when integrating the
+ * Cartesian state of a lightly perturbed orbit.  The remaining components of
+ * the integrated state (attitude, additional providers) are integrated as
+ * they are.
+ *
+ * The interface matches `numerical_propagator`, spacecraft and event detectors
+ * only ever see the Cartesian integrated state.
+ *
+ * @tparam Stepper The stepper used for the elements (see boost docs)
+ */
+template <typename Stepper>
+class equinoctial_propagator
+{
+  integrator<Stepper> m_integrator;
+  std::shared_ptr<equations_of_motion> _system_eoms;
+  std::map<std::string, std::shared_ptr<spacecraft>> m_spacecrafts;
+  event_locator m_events;
+  double m_mu = constants::EARTH_MU;
+  double m_t = 0.0;
+
+  /**
+   * Dynamics of the integrated state with position and velocity replaced by
+   * the equinoctial elements.
+   */
+  auto make_system(const std::shared_ptr<spacecraft>& spacecraft)
+  {
+    auto system_eoms = _system_eoms;
+    const auto provider_map = spacecraft->get_state().get_provider_mapping();
+    const double mu = m_mu;
+    return [system_eoms, provider_map, mu](const vector_type& y, vector_type& dydt, double t)
+        {
+          const orbits::equinoctial_orbit elements(pv_state_type(y.subvec(0, 5)));
+          vector_type x = y;
+          x.subvec(0, 5) = elements.to_cartesian(mu);
+
+          vector_type dxdt(x.n_elem);
+          for (const auto& [fst, snd] : provider_map) {
+            if (auto eoms = snd->get_eoms(); eoms == nullptr) {
+              dxdt(fst) = system_eoms->get_derivative(x(fst), t);
+            } else {
+              dxdt(fst) = eoms->get_derivative(x(fst), t);
+            }
+          }
+
+          const arma::vec3 r = x.subvec(0, 2);
+          const arma::vec3 v = x.subvec(3, 5);
+          const double rn = arma::norm(r);
+          const arma::vec3 perturbation = dxdt.subvec(3, 5) + mu / (rn * rn * rn) * r;
+
+          dydt = dxdt;
+          dydt(arma::span(0, 5)) = elements.get_derivative(orbits::to_rtn(r, v, perturbation), mu);
+        };
+  }
+
+  [[nodiscard]] vector_type to_cartesian(const vector_type& y) const
+  {
+    vector_type x = y;
+    x.subvec(0, 5) = orbits::equinoctial_orbit(pv_state_type(y.subvec(0, 5))).to_cartesian(m_mu);
+    return x;
+  }
+
+  [[nodiscard]] vector_type to_equinoctial(const vector_type& x) const
+  {
+    vector_type y = x;
+    y.subvec(0, 5) = orbits::equinoctial_orbit::from_cartesian(x.subvec(0, 2), x.subvec(3, 5), m_mu).to_vec();
+    return y;
+  }
+
+public:
+  ~equinoctial_propagator() = default;
+  equinoctial_propagator() = default;
+
+  /**
+   * @param stepper The stepper used for the elements
+   * @param abs_tol Absolute error tolerance of the stepper
+   * @param rel_tol Relative error tolerance of the stepper
+   * @param mu Gravitational parameter of the central body, the point mass
+   * term of `mu` is the unperturbed motion of the elements
+   */
+  explicit equinoctial_propagator(Stepper stepper,
+                                  const double abs_tol = 1e-6,
+                                  const double rel_tol = 1e-6,
+                                  const double mu = constants::EARTH_MU)
+      : m_integrator(std::move(stepper), abs_tol, rel_tol), m_mu(mu)
+  {
+  }
+
+  void initialize(const std::shared_ptr<equations_of_motion>& system_eoms, const std::map<std::string, std::shared_ptr<spacecraft>>& spacecrafts)
+  {
+    _system_eoms = system_eoms;
+    m_spacecrafts = spacecrafts;
+    for (const auto & [fst, sc] : m_spacecrafts) {
+      if (sc->get_maneuver_plan() != nullptr) m_events.add(sc->get_maneuver_plan());
+    }
+  }
+
+  /**
+   * Detect events of `detector` in addition to the maneuver plans of the
+   * spacecraft.
+   */
+  void add_event_detector(const std::shared_ptr<event_detector>& detector)
+  {
+    m_events.add(detector);
+  }
+
+  /**
+   * Integrate the spacecraft to `end_time`.  Like `numerical_propagator`,
+   * integration stops exactly on the times of the scheduled events and on the
+   * earliest state dependent event within each accepted step, the detectors
+   * are sampled on the Cartesian state.
+   */
+  void propagate_to(const std::shared_ptr<spacecraft>& spacecraft, const double end_time)
+  {
+    NAOMI_TRACE_SCOPE("propagate_to", spacecraft->get_identifier());
+    const system_t system = make_system(spacecraft);
+    double t = m_t;
+    vector_type y = to_equinoctial(spacecraft->get_state().get_integrated_state());
+    event_locator::event_queue scheduled = m_events.schedule_all(spacecraft->get_identifier(), t, end_time);
+
+    auto handle_event = [&](const std::shared_ptr<event_detector>& e)
+    {
+      m_events.record_event(spacecraft->get_identifier(), e, t);
+      spacecraft->get_state().set_integrated_state(to_cartesian(y));
+      e->handle_event(spacecraft, t);
+      spacecraft->update(t);
+      m_integrator.reset();
+      y = to_equinoctial(spacecraft->get_state().get_integrated_state());
+      m_events.schedule(scheduled, spacecraft->get_identifier(), e, t, end_time);
+    };
+
+    while (true) {
+      while (const auto due = m_events.pop_due(scheduled, spacecraft->get_identifier(), t)) {
+        handle_event(due);
+      }
+      if (t >= end_time) {
+        break;
+      }
+
+      const double boundary = event_locator::next_boundary(scheduled, end_time);
+      std::shared_ptr<event_detector> triggered;
+      t = m_integrator.integrate_steps(system, y, t, boundary, 0.1,
+          [this, &triggered](const double step_start, const double step_end, const step_interpolator_t& interpolate)
+          {
+            auto [event_time, detector] = m_events.find_first_event(step_start, step_end,
+                [this, &interpolate](const double time) { return state_and_time_type(to_cartesian(interpolate(time)), time); });
+            triggered = detector;
+            return detector == nullptr ? std::optional<double>() : std::optional<double>(event_time);
+          });
+      if (triggered != nullptr) {
+        handle_event(triggered);
+      }
+    }
+
+    spacecraft->get_state().set_integrated_state(to_cartesian(y));
+    spacecraft->update(end_time);
+  }
+
+  double propagate_to(const double t)
+  {
+    for (const auto & [scid, sc]: m_spacecrafts) {
+      propagate_to(sc, t);
+    }
+    m_t = t;
+    return m_t;
+  }
+
+  void propagate_by(const std::shared_ptr<spacecraft>& spacecraft, double dt)
+  {
+    propagate_to(spacecraft, m_t + dt);
+  }
+
+  double propagate_by(const double dt)
+  {
+    return propagate_to(m_t + dt);
+  }
+};
+}
+
+#endif //EQUINOCTIAL_PROPAGATOR_H
@@ -4,6 +4,8 @@
 
 #ifndef EVENT_DETECTOR_H
 #define EVENT_DETECTOR_H
+#include <optional>
+
 #include <armadillo>
 
 #include "event_handler.h"
@@ -50,6 +52,81 @@ public:
 
   [[nodiscard]] virtual double g(const state_and_time_type& sv) const = 0;
 
+  [[nodiscard]] EventDetectorTrigger get_trigger() const
+  {
+    return m_trigger;
+  }
+
+  /**
+   * @return False once the detector has no more events, e.g. a completed
+   * maneuver plan, it is then no longer sampled
+   */
+  [[nodiscard]] bool is_active() const
+  {
+    return m_is_active;
+  }
+
+  /**
+   * @return The largest time span in seconds between two evaluations of `g`,
+   * sign changes within a shorter span may be missed
+   */
+  [[nodiscard]] double get_max_check_interval() const
+  {
+    return m_max_check_interval;
+  }
+
+  /**
+   * The event time is converged once its bracket is shorter than
+   * abs_tol + rel_tol * (length of the sampled interval it was found in).
+   *
+   * @return The absolute convergence threshold in seconds
+   */
+  [[nodiscard]] double get_abs_tol() const
+  {
+    return m_abs_tol;
+  }
+
+  /**
+   * @return The relative convergence threshold
+   */
+  [[nodiscard]] double get_rel_tol() const
+  {
+    return m_rel_tol;
+  }
+
+  /**
+   * Time of the next event for detectors that only depend on time.  The
+   * propagator schedules these as step boundaries and stops exactly on them
+   * instead of searching for the root of `g`, once handled the detector has to
+   * move on to its next time or return nothing.
+   *
+   * @return The event time, nothing if the event depends on the state
+   */
+  [[nodiscard]] virtual std::optional<double> get_event_time() const
+  {
+    return std::nullopt;
+  }
+
+  /**
+   * Detectors shared by all spacecraft of a propagator (e.g. `time_detector`)
+   * have their time event once for every spacecraft, handling it doesn't move
+   * them on.  The propagator keeps which spacecraft handled the event instead.
+   *
+   * @return True if the event of `get_event_time` is due for every spacecraft
+   */
+  [[nodiscard]] virtual bool is_per_spacecraft() const
+  {
+    return false;
+  }
+
+  /**
+   * Call `handler` on every event of this detector.
+   */
+  void add_handler(const std::shared_ptr<event_handler>& handler)
+  {
+    m_handlers.push_back(handler);
+  }
+
   [[nodiscard]] bool operator()(const state_and_time_type& initial, const state_and_time_type& final) const
   {
     if (! m_is_active) return false;
@@ -82,6 +159,18 @@ struct event
 
 };
 
+/**
+ * Orders events latest first, a `std::priority_queue` of events pops the
+ * earliest one.
+ */
+struct later_event
+{
+  bool operator()(const event& a, const event& b) const
+  {
+    return a.time_occurred > b.time_occurred;
+  }
+};
+
 class apside_detector final : public event_detector
 {
 public:
@@ -112,6 +201,16 @@ public:
     return m_time - sv.second;
   }
 
+  [[nodiscard]] std::optional<double> get_event_time() const override
+  {
+    if (! m_is_active) return std::nullopt;
+    return m_time;
+  }
+
+  [[nodiscard]] bool is_per_spacecraft() const override
+  {
+    return true;
+  }
 };
 
 struct event_detector_condition
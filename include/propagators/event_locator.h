@@ -0,0 +1,241 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef EVENT_LOCATOR_H
+#define EVENT_LOCATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "propagators/event_detector.h"
+#include "propagators/propagation_stats.h"
+#include "simulation/tracing.h"
+
+namespace naomi::numeric
+{
+using namespace events;
+
+/**
+ * Event detection shared by the propagators.
+ *
+ * Detectors with a known event time are scheduled, the propagator integrates
+ * up to their times and handles them there.  Detectors are shared by all
+ * spacecraft of a propagator, which time events of per spacecraft detectors
+ * each spacecraft handled is kept here.  The state dependent detectors
+ * are sampled within every accepted step of `integrator::integrate_steps` and
+ * the earliest event of all of them is located by bisection.
+ *
+ * The steps may be taken in another variable than time (e.g. the fictitious
+ * time of a regularized propagator), a sampler maps a value of the
+ * integration variable to the Cartesian integrated state and the physical
+ * time.  Check intervals and tolerances of the detectors always apply to the
+ * physical time.
+ */
+class event_locator
+{
+  std::vector<std::shared_ptr<event_detector>> m_detectors;
+  /// Time events of per spacecraft detectors handled so far, by spacecraft
+  std::map<std::string, std::set<std::pair<const event_detector*, double>>> m_handled;
+  mutable propagation_stats m_stats;
+
+  [[nodiscard]] bool is_handled(const std::string& id, const std::shared_ptr<event_detector>& detector, const double time) const
+  {
+    const auto it = m_handled.find(id);
+    return it != m_handled.end() && it->second.count({detector.get(), time}) > 0;
+  }
+
+  /**
+   * Bisection for an event of `e` within [lower, upper] of the integration
+   * variable, the returned value lies just past the root so the event doesn't
+   * trigger again when integration resumes from it.
+   */
+  template <typename Sampler>
+  double locate_event(const std::shared_ptr<event_detector>& e,
+                      double lower,
+                      state_and_time_type lower_state,
+                      double upper,
+                      state_and_time_type upper_state,
+                      const double step_end,
+                      const Sampler& sample) const
+  {
+    const double threshold = e->get_abs_tol() + e->get_rel_tol() * (upper_state.second - lower_state.second);
+    while (upper_state.second - lower_state.second > threshold) {
+      NAOMI_STATS(m_stats.root_finding_iterations++;)
+      const double mid = 0.5 * (lower + upper);
+      state_and_time_type mid_state = sample(mid);
+      if ((*e)(lower_state, mid_state)) {
+        upper = mid;
+        upper_state = std::move(mid_state);
+      } else {
+        lower = mid;
+        lower_state = std::move(mid_state);
+      }
+    }
+    if (e->g(upper_state) == 0.0) {
+      upper = std::min(step_end, upper + (upper - lower));
+    }
+    return upper;
+  }
+
+public:
+  typedef std::priority_queue<event, std::vector<event>, later_event> event_queue;
+
+  void add(const std::shared_ptr<event_detector>& detector)
+  {
+    m_detectors.push_back(detector);
+  }
+
+  [[nodiscard]] auto get_detectors() const -> const std::vector<std::shared_ptr<event_detector>>&
+  {
+    return m_detectors;
+  }
+
+  /**
+   * Queue the event of `detector` for spacecraft `id` if it has a known time
+   * within [start_time, end_time] the spacecraft hasn't handled yet.  Called
+   * again after handling a detector, which may have moved it on to another
+   * time event.
+   */
+  void schedule(event_queue& queue, const std::string& id, const std::shared_ptr<event_detector>& detector, const double start_time, const double end_time) const
+  {
+    if (const auto time = detector->get_event_time();
+        time && *time >= start_time && *time <= end_time && ! is_handled(id, detector, *time)) {
+      queue.push({*time, detector});
+    }
+  }
+
+  [[nodiscard]] event_queue schedule_all(const std::string& id, const double start_time, const double end_time) const
+  {
+    event_queue queue;
+    for (const std::shared_ptr<event_detector>& e: m_detectors) {
+      schedule(queue, id, e, start_time, end_time);
+    }
+    return queue;
+  }
+
+  /**
+   * Pop the next queued event of spacecraft `id` due at `t`, entries whose
+   * detector has moved on since they were queued are skipped.
+   *
+   * @return The detector of the event, nullptr once no event is due
+   */
+  std::shared_ptr<event_detector> pop_due(event_queue& queue, const std::string& id, const double t) const
+  {
+    while (! queue.empty() && queue.top().time_occurred <= t) {
+      const event due = queue.top();
+      queue.pop();
+      if (due.detector->get_event_time() == due.time_occurred && ! is_handled(id, due.detector, due.time_occurred)) {
+        return due.detector;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @return The time integration has to stop at next, the earliest queued
+   * event or `end_time`
+   */
+  [[nodiscard]] static double next_boundary(const event_queue& queue, const double end_time)
+  {
+    return queue.empty() ? end_time : queue.top().time_occurred;
+  }
+
+  /**
+   * Sample the active state dependent detectors within an accepted step, no
+   * further apart in physical time than the smallest `max_check_interval`,
+   * and locate the earliest event of all of them.
+   *
+   * @param step_start Start of the step in the integration variable
+   * @param step_end End of the step in the integration variable
+   * @param sample Callable mapping a value of the integration variable within
+   * the step to the Cartesian integrated state and the physical time
+   * @return The value of the integration variable and the detector of the
+   * earliest event within the step, the detector is nullptr if there is none
+   */
+  template <typename Sampler>
+  std::pair<double, std::shared_ptr<event_detector>> find_first_event(const double step_start,
+                                                                      const double step_end,
+                                                                      const Sampler& sample) const
+  {
+    double max_check_interval = std::numeric_limits<double>::infinity();
+    for (const std::shared_ptr<event_detector>& e: m_detectors) {
+      if (e->is_active() && ! e->get_event_time()) {
+        max_check_interval = std::min(max_check_interval, e->get_max_check_interval());
+      }
+    }
+    if (std::isinf(max_check_interval)) {
+      return {step_end, nullptr};
+    }
+    NAOMI_TRACE_SCOPE("find_first_event");
+    NAOMI_STATS(const scoped_stats_timer timer(m_stats.event_time);)
+
+    double v0 = step_start;
+    state_and_time_type x0 = sample(v0);
+    state_and_time_type end_state = sample(step_end);
+    const double span = std::abs(end_state.second - x0.second);
+    const auto n_checks = static_cast<std::size_t>(std::max(1.0, std::ceil(span / max_check_interval)));
+    for (std::size_t i = 1; i <= n_checks; i++) {
+      const double v1 = i == n_checks
+          ? step_end
+          : step_start + (step_end - step_start) * static_cast<double>(i) / static_cast<double>(n_checks);
+      state_and_time_type x1 = i == n_checks ? std::move(end_state) : sample(v1);
+      std::pair<double, std::shared_ptr<event_detector>> first = {step_end, nullptr};
+      for (const std::shared_ptr<event_detector>& e: m_detectors) {
+        if (! e->is_active() || e->get_event_time()) {
+          continue;
+        }
+        NAOMI_STATS(m_stats.event_checks++;)
+        if ((*e)(x0, x1)) {
+          const double at = locate_event(e, v0, x0, v1, x1, step_end, sample);
+          if (first.second == nullptr || at < first.first) {
+            first = {at, e};
+          }
+        }
+      }
+      if (first.second != nullptr) {
+        return first;
+      }
+      v0 = v1;
+      x0 = std::move(x1);
+    }
+    return {step_end, nullptr};
+  }
+
+  /**
+   * Count an event of `detector` at `t` the propagator is about to handle for
+   * spacecraft `id`, and remember it if `detector` is per spacecraft.
+   */
+  void record_event(const std::string& id, const std::shared_ptr<event_detector>& detector, const double t)
+  {
+    NAOMI_STATS(m_stats.events_located++;)
+    if (detector->is_per_spacecraft() && detector->get_event_time() == t) {
+      m_handled[id].insert({detector.get(), t});
+    }
+  }
+
+  /**
+   * @return Counters and timers of the event handling since the last
+   * `reset_stats`, all zero unless built with NAOMI_ENABLE_STATS
+   */
+  [[nodiscard]] const propagation_stats& get_stats() const
+  {
+    return m_stats;
+  }
+
+  void reset_stats()
+  {
+    m_stats = {};
+  }
+};
+}
+
+#endif //EVENT_LOCATOR_H
@@ -5,53 +5,18 @@
 #ifndef NUMERICAL_PROPAGATOR_H
 #define NUMERICAL_PROPAGATOR_H
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 #include <armadillo>
 #include "boost/numeric/odeint.hpp"
 #include "integrators/integrator.h"
+#include "integrators/odeint_armadillo.h"
 #include "spacecraft/spacecraft.h"
 #include "forces/force_model.h"
-
-using namespace naomi;
-
-template<>
-struct boost::numeric::odeint::vector_space_norm_inf<vector_type>
-{
-  typedef double result_type;
-
-  result_type operator()(const vector_type& s) const
-  {
-    return arma::norm(s, "inf");
-  }
-};  // namespace boost::numeric::odeint
-
-namespace boost::numeric::odeint
-{
-
-template<>
-struct is_resizeable<arma::vec>
-{
-  typedef true_type type;
-  const static bool value = type::value;
-};
-
-template<>
-struct same_size_impl<arma::vec, arma::vec>
-{
-  static bool same_size(const arma::vec& x, const arma::vec& y)
-  {
-    return x.size() == y.size();  // or use .n_elem attributes
-  }
-};
-
-template<>
-struct resize_impl<arma::vec, arma::vec>
-{
-  static void resize(arma::vec& v1, const arma::vec& v2)
-  {
-    v1.resize(v2.size());  // not sure if this is correct for arma
-  }
-};
-}
+#include "propagators/event_locator.h"
+#include "simulation/tracing.h"
 
 namespace naomi::numeric
 {
@@ -68,7 +33,7 @@ public:
       , m_system(other.m_system)
       , m_spacecrafts(other.m_spacecrafts)
       , _system_eoms(other._system_eoms)
-      , m_event_detectors(other.m_event_detectors)
+      , m_events(other.m_events)
       , m_t(other.m_t)
   {
   }
@@ -77,7 +42,7 @@ public:
       , m_system(std::move(other.m_system))
       , m_spacecrafts(std::move(other.m_spacecrafts))
       , _system_eoms(std::move(other._system_eoms))
-      , m_event_detectors(std::move(other.m_event_detectors))
+      , m_events(std::move(other.m_events))
       , m_t(other.m_t)
   {
   }
@@ -89,7 +54,7 @@ public:
     m_system = other.m_system;
     m_spacecrafts = other.m_spacecrafts;
     _system_eoms = other._system_eoms;
-    m_event_detectors = other.m_event_detectors;
+    m_events = other.m_events;
     m_t = other.m_t;
     return *this;
   }
@@ -101,7 +66,7 @@ public:
     m_system = std::move(other.m_system);
     m_spacecrafts = std::move(other.m_spacecrafts);
     _system_eoms = std::move(other._system_eoms);
-    m_event_detectors = std::move(other.m_event_detectors);
+    m_events = std::move(other.m_events);
     m_t = other.m_t;
     return *this;
   }
@@ -111,22 +76,62 @@ private:
   std::shared_ptr<force_model> m_system;
   std::shared_ptr<equations_of_motion> _system_eoms;
   std::map<std::string, std::shared_ptr<spacecraft>> m_spacecrafts;
-  std::vector<std::shared_ptr<event_detector>> m_event_detectors = {};
+  /// Event detectors and event statistics, the integrator keeps its own
+  event_locator m_events;
   double m_t = 0.0;
 
 public:
   ~numerical_propagator() = default;
   numerical_propagator() = default;
 
-  void initialize(const std::shared_ptr<equations_of_motion>& system_eoms, const std::map<std::string, std::shared_ptr<spacecraft>>& spacecrafts)
+  /**
+   * @param integrator The integrator, e.g. with non default tolerances
+   */
+  explicit numerical_propagator(integrator<Stepper> integrator)
+      : m_integrator(std::move(integrator))
+  {
+  }
+
+  void initialize(const std::shared_ptr<equations_of_motion>& system_eoms, const std::map<std::string, std::shared_ptr<spacecraft>>& spacecrafts, const double start_time = 0.0)
   {
     _system_eoms = system_eoms;
     m_spacecrafts = spacecrafts;
+    m_t = start_time;
     for (const auto & [fst, sc] : m_spacecrafts) {
-      if (sc->get_maneuver_plan() != nullptr) m_event_detectors.emplace_back(sc->get_maneuver_plan());
+      if (sc->get_maneuver_plan() != nullptr) m_events.add(sc->get_maneuver_plan());
     }
   }
 
+  /**
+   * Detect events of `detector` in addition to the maneuver plans of the
+   * spacecraft.
+   *
+   * @param detector The event detector, its `handle_event` is called with the
+   * spacecraft and the time of every event
+   */
+  void add_event_detector(const std::shared_ptr<event_detector>& detector)
+  {
+    m_events.add(detector);
+  }
+
+  /**
+   * @return Counters and timers of the integration and the event handling
+   * since the last `reset_stats`, all zero unless built with
+   * NAOMI_ENABLE_STATS
+   */
+  [[nodiscard]] propagation_stats get_stats() const
+  {
+    propagation_stats stats = m_events.get_stats();
+    stats += m_integrator.get_stats();
+    return stats;
+  }
+
+  void reset_stats()
+  {
+    m_events.reset_stats();
+    m_integrator.reset_stats();
+  }
+
   std::vector<std::pair<arma::span, std::shared_ptr<additional_state_provider>>> map_providers(
     const std::vector<std::shared_ptr<additional_state_provider>>& additional_providers
   )
@@ -144,17 +149,6 @@ public:
       return providers;
     }
 
-  std::vector<std::shared_ptr<event_detector>> check_events(const state_and_time_type& prev, const state_and_time_type& curr, double t)
-  {
-    std::vector<std::shared_ptr<event_detector>> active_events;
-    for(const std::shared_ptr<event_detector>& e: m_event_detectors) {
-      if ((*e)(prev, curr)) {
-        active_events.push_back(e);
-      }
-    }
-    return active_events;
-  }
-
   auto make_system(const std::shared_ptr<force_model>& force_model,
                    const std::shared_ptr<spacecraft>& spacecraft)
   {
@@ -173,47 +167,55 @@ public:
         };
   }
 
-  static std::vector<double> get_integration_times(const double t_start,
-                                                   const double t_end)
+  /**
+   * Integrate the spacecraft to `end_time`.  Detectors with a known event
+   * time are queued and integration stops exactly on their times, the other
+   * detectors are checked on every accepted step and integration stops on
+   * their events to handle them.
+   */
+  void propagate_to(const std::shared_ptr<spacecraft>& spacecraft, const double end_time)
   {
-    std::vector<double> times;
-    double t_curr = t_start;
-    double t_step = 2;
-    while (t_curr + t_step < t_end) {
-      times.push_back(t_curr);
-      t_curr += t_step;
-    }
-    times.push_back(t_end);
-    return times;
-  }
+    NAOMI_TRACE_SCOPE("propagate_to", spacecraft->get_identifier());
+    const system_t system = make_system(m_system, spacecraft);
+    vector_type state = spacecraft->get_state().get_integrated_state();
+    double t = m_t;
+    event_locator::event_queue scheduled = m_events.schedule_all(spacecraft->get_identifier(), t, end_time);
 
-  void propagate_to(const std::shared_ptr<spacecraft>& spacecraft, double dt)
-  {
-    auto system = make_system(m_system, spacecraft);
-    const double end = dt;
-    auto times = get_integration_times(m_t, end);
-    for (std::size_t i = 0; i < times.size() - 1; i++) {
-      double start_t = times[i];
-      double end_t = times[i + 1];
-      vector_type state = spacecraft->get_state().get_integrated_state();
-      state_and_time_type prev_state = {state, start_t};
-      start_t = m_integrator.integrate( system, state , start_t , end_t , 0.1 );
-      state_and_time_type new_state = {state, start_t};
-      auto active_events = check_events(prev_state, new_state, start_t);
-      for (std::shared_ptr<event_detector> e: active_events) {
-        // TODO: This wont work with multiple events
-        auto event = m_integrator.find_event_time(system, times[i], times[i+1], e, prev_state, 0.1);
-        start_t = event.first;
-        spacecraft->get_state().set_integrated_state(event.second);
-        e->handle_event(spacecraft, start_t);
-        spacecraft->update(event.first);
-        state = spacecraft->get_state().get_integrated_state();
-        std::cout << "event occurred at: " << start_t << "state: " << state << "\n";
-      }
-      m_integrator.integrate( system, state , start_t , end_t , 0.1 );
+    auto handle_event = [&](const std::shared_ptr<event_detector>& e)
+    {
+      m_events.record_event(spacecraft->get_identifier(), e, t);
       spacecraft->get_state().set_integrated_state(state);
-      spacecraft->update(end_t);
+      e->handle_event(spacecraft, t);
+      spacecraft->update(t);
+      m_integrator.reset();
+      state = spacecraft->get_state().get_integrated_state();
+      m_events.schedule(scheduled, spacecraft->get_identifier(), e, t, end_time);
+    };
+
+    while (true) {
+      while (const auto due = m_events.pop_due(scheduled, spacecraft->get_identifier(), t)) {
+        handle_event(due);
+      }
+      if (t >= end_time) {
+        break;
+      }
+
+      const double boundary = event_locator::next_boundary(scheduled, end_time);
+      std::shared_ptr<event_detector> triggered;
+      t = m_integrator.integrate_steps(system, state, t, boundary, 0.1,
+          [this, &triggered](const double step_start, const double step_end, const step_interpolator_t& interpolate)
+          {
+            auto [event_time, detector] = m_events.find_first_event(step_start, step_end,
+                [&interpolate](const double time) { return state_and_time_type(interpolate(time), time); });
+            triggered = detector;
+            return detector == nullptr ? std::optional<double>() : std::optional<double>(event_time);
+          });
+      if (triggered != nullptr) {
+        handle_event(triggered);
+      }
     }
+    spacecraft->get_state().set_integrated_state(state);
+    spacecraft->update(end_time);
   }
 
   double propagate_to(const double dt)
@@ -0,0 +1,360 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef PARAREAL_PROPAGATOR_H
+#define PARAREAL_PROPAGATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "bodies/celestial_body.h"
+#include "constants.h"
+#include "math/vector_utils.h"
+#include "orbits/orbits.h"
+#include "propagators/event_detector.h"
+#include "propagators/numerical_propagator.h"
+
+namespace naomi::numeric
+{
+using namespace events;
+using namespace bodies;
+
+/**
+ * Cheap approximate propagator used by Parareal for the serial prediction
+ * sweeps, maps a [r, v, a] state from the first time to the second.
+ */
+typedef std::function<vector_type(const vector_type&, double, double)> coarse_solver_t;
+
+/**
+ * Coarse solver following the osculating Kepler conic with the secular J2
+ * drift of the node, the argument of periapsis and the mean anomaly.
+ *
+ * @param body The central body, provides mu and J2 R^2 through its potential
+ * parameters
+ * @return The coarse solver
+ */
+inline coarse_solver_t make_kepler_j2_coarse_solver(const std::shared_ptr<celestial_body>& body)
+{
+  const double mu = body->get_mu();
+  // c = mu J2 R^2 / 2
+  const double j2_r2 = 2 * body->get_potential_parameters().at("c") / mu;
+  return [mu, j2_r2](const vector_type& x, const double t0, const double t1)
+  {
+    const arma::vec3 r = x.subvec(0, 2);
+    const arma::vec3 v = x.subvec(3, 5);
+    const double dt = t1 - t0;
+    vector_type out = x;
+
+    const arma::vec3 h = arma::cross(r, v);
+    const double p = arma::dot(h, h) / mu;
+    const arma::vec3 e_vec = arma::cross(v, h) / mu - arma::normalise(r);
+    const double e2 = arma::dot(e_vec, e_vec);
+    if (e2 >= 1) {
+      out.subvec(0, 5) = orbits::kepler_propagate(r, v, dt, mu);
+      return out;
+    }
+
+    const double a = p / (1 - e2);
+    const double n = std::sqrt(mu / (a * a * a));
+    const double cos_i = h(2) / arma::norm(h);
+    // (3/2) n J2 (R/p)^2
+    const double k = 1.5 * n * j2_r2 / (p * p);
+    const double raan_rate = -k * cos_i;
+    const double aop_rate = 0.5 * k * (5 * cos_i * cos_i - 1);
+    const double ma_rate = 0.5 * k * std::sqrt(1 - e2) * (3 * cos_i * cos_i - 1);
+
+    const pv_state_type pv = orbits::kepler_propagate(r, v, dt * (1 + ma_rate / n), mu);
+    const arma::mat33 rotation = math::axis_angle_rotation(constants::PLUS_K, raan_rate * dt)
+        * math::axis_angle_rotation(arma::normalise(h), aop_rate * dt);
+    out.subvec(0, 2) = rotation * pv.subvec(0, 2);
+    out.subvec(3, 5) = rotation * pv.subvec(3, 5);
+    return out;
+  };
+}
+
+/**
+ * Coarse solver integrating the full equations of motion with large fixed
+ * RK4 steps.
+ *
+ * @param eoms The equations of motion
+ * @param dt The step size in seconds
+ * @return The coarse solver
+ */
+inline coarse_solver_t make_rk4_coarse_solver(const std::shared_ptr<equations_of_motion>& eoms, const double dt)
+{
+  return [eoms, dt](const vector_type& x, const double t0, const double t1)
+  {
+    const system_t system = [eoms](const vector_type& s, vector_type& dsdt, const double t)
+    {
+      dsdt = eoms->get_derivative(s, t);
+    };
+    boost::numeric::odeint::runge_kutta4<
+      vector_type, double, vector_type, double,
+      boost::numeric::odeint::vector_space_algebra> stepper;
+    vector_type out = x;
+    const auto n_steps = static_cast<std::size_t>(std::ceil((t1 - t0) / dt));
+    const double h = (t1 - t0) / static_cast<double>(std::max<std::size_t>(n_steps, 1));
+    double t = t0;
+    for (std::size_t i = 0; i < n_steps; i++) {
+      stepper.do_step(system, out, t, h);
+      t += h;
+    }
+    return out;
+  };
+}
+
+/**
+ * Event detector recording the times its wrapped detector fires, without
+ * calling the wrapped detector's handlers.  Since the wrapped detector is never
+ * handled it can't move on from a time event, the recorder deactivates once
+ * that event is recorded.
+ */
+class event_recorder final : public event_detector
+{
+  std::shared_ptr<event_detector> m_detector;
+  std::vector<double> m_times;
+
+public:
+  explicit event_recorder(const std::shared_ptr<event_detector>& detector)
+      : event_detector(detector->get_trigger()), m_detector(detector)
+  {
+  }
+
+  [[nodiscard]] double g(const state_and_time_type& sv) const override
+  {
+    return m_detector->g(sv);
+  }
+
+  [[nodiscard]] std::optional<double> get_event_time() const override
+  {
+    if (! m_is_active) return std::nullopt;
+    return m_detector->get_event_time();
+  }
+
+  void handle_event(const std::shared_ptr<spacecraft>&, const double t) override
+  {
+    m_times.push_back(t);
+    if (m_detector->get_event_time()) m_is_active = false;
+  }
+
+  [[nodiscard]] auto get_times() const -> const std::vector<double>&
+  {
+    return m_times;
+  }
+};
+
+/**
+ * Outcome of a Parareal propagation.
+ */
+struct parareal_result
+{
+  /// Slice boundaries, the first is the start and the last the end time
+  std::vector<double> times;
+  /// Integrated state at each slice boundary
+  std::vector<vector_type> states;
+  /// Events found by the fine solver in the converged iteration, in time order
+  std::vector<event> events;
+  /// Number of fine sweeps
+  std::size_t iterations = 0;
+  /// Wall time of the Parareal propagation in seconds
+  double wall_time = 0.0;
+  /// Summed wall time of the fine solves of one sweep, i.e. the cost of a
+  /// serial fine propagation, in seconds
+  double serial_time = 0.0;
+  /// serial_time / wall_time
+  double speedup = 0.0;
+};
+
+/**
+ * Parareal parallel-in-time propagation of a single spacecraft over a long
+ * arc.
+ *
+ * The arc is cut into time slices.  A cheap coarse solver predicts the slice
+ * boundary states serially, then a `numerical_propagator` refines every slice
+ * concurrently, and the prediction is corrected with the difference between
+ * the fine and the coarse solution:
+ *
+ *   U[n+1] = G(U_new[n]) + F(U_old[n]) - G(U_old[n])
+ *
+ * until the boundary positions move less than the tolerance between two
+ * iterations.  After k iterations the first k slices are exact, so the
+ * iteration converges to the serial fine solution in at most as many
+ * iterations as there are slices; each iteration only refines the slices that
+ * are not converged yet.
+ *
+ * Event detectors are only observed, the events reported are the ones the
+ * fine solver found in the converged iteration, which are the events of a
+ * serial run to within the tolerance.  Spacecraft with a maneuver plan are
+ * rejected since maneuvers change the trajectory and serialize the arc,
+ * propagate the arcs between maneuvers instead.
+ *
+ * @tparam Stepper The stepper of the fine solver (see boost docs)
+ */
+template <typename Stepper>
+class parareal_propagator
+{
+  std::shared_ptr<spacecraft> m_spacecraft;
+  std::shared_ptr<equations_of_motion> m_eoms;
+  coarse_solver_t m_coarse;
+  std::vector<std::shared_ptr<event_detector>> m_event_detectors;
+  double m_tolerance;
+  std::size_t m_n_slices;
+
+  struct fine_solution
+  {
+    vector_type state;
+    std::vector<event> events;
+    double wall_time;
+  };
+
+  fine_solution solve_fine(const vector_type& x, const double t0, const double t1) const
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const auto sc = std::make_shared<spacecraft>(
+        m_spacecraft->get_identifier(), x, m_spacecraft->get_state().get_mass());
+    numerical_propagator<Stepper> fine;
+    fine.initialize(m_eoms, {{sc->get_identifier(), sc}}, t0);
+    std::vector<std::shared_ptr<event_recorder>> recorders;
+    for (const auto& detector : m_event_detectors) {
+      recorders.push_back(std::make_shared<event_recorder>(detector));
+      fine.add_event_detector(recorders.back());
+    }
+    fine.propagate_to(t1);
+
+    std::vector<event> events;
+    for (std::size_t i = 0; i < recorders.size(); i++) {
+      for (const double t : recorders[i]->get_times()) {
+        events.push_back({t, m_event_detectors[i]});
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {sc->get_state().get_integrated_state(), events, elapsed.count()};
+  }
+
+public:
+  /**
+   * @param sc The spacecraft, its integrated state must be the [r, v, a]
+   * state of a `pv_coordinates_provider`
+   * @param eoms The equations of motion of the fine solver
+   * @param coarse The coarse solver
+   * @param tolerance Convergence tolerance on the slice boundary positions in
+   * meters
+   * @param n_slices Number of time slices, defaults to the number of hardware
+   * threads
+   */
+  parareal_propagator(const std::shared_ptr<spacecraft>& sc,
+                      const std::shared_ptr<equations_of_motion>& eoms,
+                      coarse_solver_t coarse,
+                      const double tolerance = 1e-3,
+                      const std::size_t n_slices = 0)
+      : m_spacecraft(sc)
+      , m_eoms(eoms)
+      , m_coarse(std::move(coarse))
+      , m_tolerance(tolerance)
+      , m_n_slices(n_slices > 0 ? n_slices : std::max(1u, std::thread::hardware_concurrency()))
+  {
+    if (sc->get_maneuver_plan() != nullptr) {
+      throw std::runtime_error(fmt::format(
+          "Parareal can't propagate spacecraft {} with a maneuver plan, propagate the arcs between maneuvers",
+          sc->get_identifier()));
+    }
+    if (const auto size = sc->get_state().get_integrated_state().n_elem; size != 9) {
+      throw std::runtime_error(fmt::format(
+          "Parareal propagates [r, v, a] states of size 9, spacecraft {} has an integrated state of size {}",
+          sc->get_identifier(), size));
+    }
+  }
+
+  void add_event_detector(const std::shared_ptr<event_detector>& detector)
+  {
+    m_event_detectors.push_back(detector);
+  }
+
+  /**
+   * Propagate the spacecraft from `start_time` to `end_time`, the spacecraft
+   * is updated to the final state.
+   */
+  parareal_result propagate(const double start_time, const double end_time)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t n = m_n_slices;
+    parareal_result result;
+    for (std::size_t i = 0; i <= n; i++) {
+      result.times.push_back(start_time + (end_time - start_time) * static_cast<double>(i) / static_cast<double>(n));
+    }
+    const auto& times = result.times;
+
+    // Serial coarse prediction
+    std::vector<vector_type> u(n + 1);
+    std::vector<vector_type> coarse(n + 1);
+    u[0] = m_spacecraft->get_state().get_integrated_state();
+    for (std::size_t i = 0; i < n; i++) {
+      coarse[i + 1] = m_coarse(u[i], times[i], times[i + 1]);
+      u[i + 1] = coarse[i + 1];
+    }
+
+    std::vector<fine_solution> fine(n);
+    for (std::size_t k = 0; k < n; k++) {
+      // Slices before k are converged, their fine solution is final
+      std::vector<std::future<fine_solution>> futures;
+      for (std::size_t i = k; i < n; i++) {
+        futures.push_back(std::async(std::launch::async,
+                                     [this, &u, &times, i] { return solve_fine(u[i], times[i], times[i + 1]); }));
+      }
+      double sweep_time = 0.0;
+      for (std::size_t i = k; i < n; i++) {
+        fine[i] = futures[i - k].get();
+        sweep_time += fine[i].wall_time;
+      }
+      if (k == 0) {
+        result.serial_time = sweep_time;
+      }
+      result.iterations = k + 1;
+
+      // Serial correction
+      double max_change = 0.0;
+      std::vector<vector_type> u_next = u;
+      u_next[k + 1] = fine[k].state;
+      for (std::size_t i = k + 1; i < n; i++) {
+        const vector_type prediction = m_coarse(u_next[i], times[i], times[i + 1]);
+        u_next[i + 1] = prediction + fine[i].state - coarse[i + 1];
+        coarse[i + 1] = prediction;
+      }
+      for (std::size_t i = k + 1; i <= n; i++) {
+        max_change = std::max(max_change, arma::norm(u_next[i].subvec(0, 2) - u[i].subvec(0, 2)));
+      }
+      u = u_next;
+      if (max_change < m_tolerance) {
+        break;
+      }
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      for (const event& e : fine[i].events) {
+        // Both slices find an event on the boundary between them
+        if (i == 0 || e.time_occurred > times[i]) result.events.push_back(e);
+      }
+    }
+    std::sort(result.events.begin(), result.events.end(),
+              [](const event& a, const event& b) { return a.time_occurred < b.time_occurred; });
+    result.states = u;
+
+    m_spacecraft->get_state().set_integrated_state(u[n]);
+    m_spacecraft->update(end_time);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.wall_time = elapsed.count();
+    result.speedup = result.serial_time / result.wall_time;
+    return result;
+  }
+};
+}
+
+#endif //PARAREAL_PROPAGATOR_H
@@ -0,0 +1,124 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef PROPAGATION_STATS_H
+#define PROPAGATION_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+#include <fmt/core.h>
+
+/**
+ * Statistics are only collected when built with NAOMI_ENABLE_STATS=1 (CMake
+ * option NAOMI_ENABLE_STATS), otherwise every `NAOMI_STATS(...)` statement
+ * compiles to nothing and all counters stay zero.
+ */
+#ifndef NAOMI_ENABLE_STATS
+#define NAOMI_ENABLE_STATS 0
+#endif
+
+#if NAOMI_ENABLE_STATS
+#define NAOMI_STATS(statement) statement
+#else
+#define NAOMI_STATS(statement)
+#endif
+
+namespace naomi::numeric
+{
+/**
+ * Counters and timers of a propagation run, times are wall clock seconds.
+ */
+struct propagation_stats
+{
+  std::size_t rhs_evaluations = 0;
+  /// Steps kept by the stepper, for dense output steppers rejected trial
+  /// steps happen inside the stepper and aren't counted
+  std::size_t accepted_steps = 0;
+  std::size_t rejected_steps = 0;
+  double min_step = std::numeric_limits<double>::infinity();
+  double max_step = 0;
+  /// Evaluations of an event detector on a sampled interval
+  std::size_t event_checks = 0;
+  std::size_t root_finding_iterations = 0;
+  std::size_t events_located = 0;
+  std::size_t observer_callbacks = 0;
+
+  double rhs_time = 0;
+  /// Time in the stepper excluding the RHS evaluations
+  double stepper_time = 0;
+  /// Time sampling detectors and locating events, including the
+  /// interpolation
+  double event_time = 0;
+  double observer_time = 0;
+
+  void record_step(const double dt)
+  {
+    accepted_steps++;
+    min_step = std::min(min_step, dt);
+    max_step = std::max(max_step, dt);
+  }
+
+  propagation_stats& operator+=(const propagation_stats& other)
+  {
+    rhs_evaluations += other.rhs_evaluations;
+    accepted_steps += other.accepted_steps;
+    rejected_steps += other.rejected_steps;
+    min_step = std::min(min_step, other.min_step);
+    max_step = std::max(max_step, other.max_step);
+    event_checks += other.event_checks;
+    root_finding_iterations += other.root_finding_iterations;
+    events_located += other.events_located;
+    observer_callbacks += other.observer_callbacks;
+    rhs_time += other.rhs_time;
+    stepper_time += other.stepper_time;
+    event_time += other.event_time;
+    observer_time += other.observer_time;
+    return *this;
+  }
+
+  [[nodiscard]] std::string to_json() const
+  {
+    return fmt::format(
+        R"({{"rhs_evaluations": {}, "accepted_steps": {}, "rejected_steps": {}, "min_step": {}, "max_step": {}, )"
+        R"("event_checks": {}, "root_finding_iterations": {}, "events_located": {}, "observer_callbacks": {}, )"
+        R"("rhs_time": {}, "stepper_time": {}, "event_time": {}, "observer_time": {}}})",
+        rhs_evaluations, accepted_steps, rejected_steps, accepted_steps > 0 ? min_step : 0.0, max_step,
+        event_checks, root_finding_iterations, events_located, observer_callbacks,
+        rhs_time, stepper_time, event_time, observer_time);
+  }
+};
+
+/**
+ * @return A monotonic wall clock in seconds
+ */
+inline double stats_clock()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Adds the time until its destruction to a timer of `propagation_stats`.
+ */
+class scoped_stats_timer
+{
+  double& m_timer;
+  double m_start = stats_clock();
+
+public:
+  explicit scoped_stats_timer(double& timer): m_timer(timer){}
+  scoped_stats_timer(const scoped_stats_timer&) = delete;
+  scoped_stats_timer& operator=(const scoped_stats_timer&) = delete;
+
+  ~scoped_stats_timer()
+  {
+    m_timer += stats_clock() - m_start;
+  }
+};
+}
+
+#endif //PROPAGATION_STATS_H
@@ -0,0 +1,273 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef REGULARIZED_PROPAGATOR_H
+#define REGULARIZED_PROPAGATOR_H
+
+#include <cmath>
+#include <stdexcept>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include "integrators/integrator.h"
+#include "integrators/odeint_armadillo.h"
+#include "constants.h"
+#include "propagators/event_detector.h"
+#include "propagators/event_locator.h"
+#include "simulation/tracing.h"
+#include "spacecraft/spacecraft.h"
+
+namespace naomi::numeric
+{
+using namespace events;
+using namespace maneuvers;
+
+/**
+ * Propagator integrating the spacecraft dynamics in the fictitious time `s` of
+ * the Sundman transformation dt = r ds.
+ *
+ * Steps taken in `s` correspond to steps in eccentric anomaly, they are long
+ * at apoapsis and short at periapsis, so highly eccentric orbits no longer
+ * force the stepper through periapsis with a tiny uniform step.  All
+ * derivatives of the wrapped `equations_of_motion` (including every
+ * perturbation) are scaled by r and the physical time is carried as an extra
+ * state component with dt/ds = r.
+ *
+ * The interface matches `numerical_propagator`: the spacecraft states and the
+ * states seen by event detectors are the Cartesian integrated states at
+ * physical times, and `propagate_to` lands exactly on the requested time.
+ *
+ * @tparam Stepper The stepper used in fictitious time (see boost docs)
+ */
+template <typename Stepper>
+class regularized_propagator
+{
+  integrator<Stepper> m_integrator;
+  std::shared_ptr<equations_of_motion> _system_eoms;
+  std::map<std::string, std::shared_ptr<spacecraft>> m_spacecrafts;
+  event_locator m_events;
+  double m_mu = constants::EARTH_MU;
+  double m_steps_per_orbit = 16;
+  double m_time_tol = 1e-12;  // relative to the target time
+  double m_t = 0.0;
+
+  [[nodiscard]] double get_time_tol(const double t) const
+  {
+    return m_time_tol * std::max(1.0, std::abs(t));
+  }
+
+  /**
+   * Equations of motion of the spacecraft in fictitious time, the state is
+   * the integrated state of the spacecraft followed by the physical time.
+   */
+  auto make_system(const std::shared_ptr<spacecraft>& spacecraft)
+  {
+    auto system_eoms = _system_eoms;
+    const auto provider_map = spacecraft->get_state().get_provider_mapping();
+    return [system_eoms, provider_map](const vector_type& x, vector_type& dxdt, double)
+        {
+          const std::size_t time_idx = x.n_elem - 1;
+          const double t = x(time_idx);
+          const double r = arma::norm(x.subvec(0, 2));
+          for (const auto& [fst, snd] : provider_map) {
+            if (auto eoms = snd->get_eoms(); eoms == nullptr) {
+              dxdt(fst) = r * system_eoms->get_derivative(x(fst), t);
+            } else {
+              dxdt(fst) = r * eoms->get_derivative(x(fst), t);
+            }
+          }
+          dxdt(time_idx) = r;
+        };
+  }
+
+  static double get_time(const vector_type& x)
+  {
+    return x(x.n_elem - 1);
+  }
+
+  static state_and_time_type to_physical(const vector_type& x)
+  {
+    return {x.head(x.n_elem - 1), get_time(x)};
+  }
+
+  /**
+   * Fictitious time span of one call to `integrate_steps`, aimed at the
+   * target time and limited to a fraction of the osculating orbit, which also
+   * bounds the step size.
+   */
+  [[nodiscard]] double get_step(const vector_type& x, const double end_time) const
+  {
+    const double r = arma::norm(x.subvec(0, 2));
+    const double v = arma::norm(x.subvec(3, 5));
+    double ds = (end_time - get_time(x)) / r;
+    // ds per orbit is 2 pi sqrt(a / mu) for dt = r ds
+    if (const double alpha = 2 / r - v * v / m_mu; alpha > 0) {
+      ds = std::min(ds, 2 * arma::datum::pi / (m_steps_per_orbit * std::sqrt(m_mu * alpha)));
+    }
+    return ds;
+  }
+
+  /**
+   * Regula falsi (Illinois) on the interpolated physical time for the
+   * fictitious time within [a, b] at which `time` is reached.
+   */
+  [[nodiscard]] double find_time(const step_interpolator_t& interpolate, double a, double b, const double time) const
+  {
+    double fa = get_time(interpolate(a)) - time;
+    double fb = get_time(interpolate(b)) - time;
+    double s = b;
+    double f = fb;
+    int side = 0;
+    const double time_tol = get_time_tol(time);
+    for (int i = 0; i < 100 && std::abs(f) > time_tol; i++) {
+      s = (a * fb - b * fa) / (fb - fa);
+      f = get_time(interpolate(s)) - time;
+      if (f > 0) {
+        b = s; fb = f;
+        if (side == -1) fa /= 2;
+        side = -1;
+      } else {
+        a = s; fa = f;
+        if (side == 1) fb /= 2;
+        side = 1;
+      }
+    }
+    if (std::abs(f) > time_tol) {
+      throw std::runtime_error(fmt::format(
+          "Regularized propagation failed to reach t = {}, stopped at t = {}", time, time + f));
+    }
+    return s;
+  }
+
+public:
+  ~regularized_propagator() = default;
+  regularized_propagator() = default;
+
+  /**
+   * @param stepper The stepper used in fictitious time
+   * @param abs_tol Absolute error tolerance of the stepper
+   * @param rel_tol Relative error tolerance of the stepper
+   * @param mu Gravitational parameter of the central body, only used to size
+   * the fictitious time steps
+   * @param steps_per_orbit Minimum number of steps per osculating orbit
+   */
+  explicit regularized_propagator(Stepper stepper,
+                                  const double abs_tol = 1e-6,
+                                  const double rel_tol = 1e-6,
+                                  const double mu = constants::EARTH_MU,
+                                  const double steps_per_orbit = 16)
+      : m_integrator(std::move(stepper), abs_tol, rel_tol), m_mu(mu), m_steps_per_orbit(steps_per_orbit)
+  {
+  }
+
+  void initialize(const std::shared_ptr<equations_of_motion>& system_eoms, const std::map<std::string, std::shared_ptr<spacecraft>>& spacecrafts)
+  {
+    _system_eoms = system_eoms;
+    m_spacecrafts = spacecrafts;
+    for (const auto & [fst, sc] : m_spacecrafts) {
+      if (sc->get_maneuver_plan() != nullptr) m_events.add(sc->get_maneuver_plan());
+    }
+  }
+
+  /**
+   * Detect events of `detector` in addition to the maneuver plans of the
+   * spacecraft.
+   */
+  void add_event_detector(const std::shared_ptr<event_detector>& detector)
+  {
+    m_events.add(detector);
+  }
+
+  /**
+   * Integrate the spacecraft to `end_time`.  One integrator runs in
+   * fictitious time until the physical time reaches the next scheduled event
+   * or `end_time`, the crossing is found on the dense output of the step.
+   * The state dependent detectors are sampled within every accepted step and
+   * integration stops on the earliest event.
+   */
+  void propagate_to(const std::shared_ptr<spacecraft>& spacecraft, const double end_time)
+  {
+    NAOMI_TRACE_SCOPE("propagate_to", spacecraft->get_identifier());
+    const system_t system = make_system(spacecraft);
+    vector_type x = arma::join_cols(spacecraft->get_state().get_integrated_state(), vector_type{m_t});
+    const std::size_t time_idx = x.n_elem - 1;
+    const double time_tol = get_time_tol(end_time);
+    double s = 0.0;
+    event_locator::event_queue scheduled = m_events.schedule_all(spacecraft->get_identifier(), m_t, end_time);
+
+    auto handle_event = [&](const std::shared_ptr<event_detector>& e)
+    {
+      const double t = x(time_idx);
+      m_events.record_event(spacecraft->get_identifier(), e, t);
+      spacecraft->get_state().set_integrated_state(x.head(time_idx));
+      e->handle_event(spacecraft, t);
+      spacecraft->update(t);
+      m_integrator.reset();
+      x = arma::join_cols(spacecraft->get_state().get_integrated_state(), vector_type{t});
+      m_events.schedule(scheduled, spacecraft->get_identifier(), e, t, end_time);
+    };
+
+    while (true) {
+      while (const auto due = m_events.pop_due(scheduled, spacecraft->get_identifier(), x(time_idx))) {
+        handle_event(due);
+      }
+      if (end_time - x(time_idx) <= time_tol) {
+        break;
+      }
+
+      const double boundary = event_locator::next_boundary(scheduled, end_time);
+      const double ds = get_step(x, boundary);
+      std::shared_ptr<event_detector> triggered;
+      bool reached = false;
+      s = m_integrator.integrate_steps(system, x, s, s + ds, ds / 10,
+          [this, boundary, &triggered, &reached](const double step_start, const double step_end, const step_interpolator_t& interpolate)
+          {
+            double limit = step_end;
+            if (get_time(interpolate(step_end)) > boundary - get_time_tol(boundary)) {
+              limit = find_time(interpolate, step_start, step_end, boundary);
+              reached = true;
+            }
+            auto [event_s, detector] = m_events.find_first_event(step_start, limit,
+                [&interpolate](const double fictitious) { return to_physical(interpolate(fictitious)); });
+            if (detector != nullptr) {
+              triggered = detector;
+              reached = false;
+              return std::optional<double>(event_s);
+            }
+            return reached ? std::optional<double>(limit) : std::optional<double>();
+          });
+      if (triggered != nullptr) {
+        handle_event(triggered);
+      } else if (reached) {
+        x(time_idx) = boundary;
+      }
+    }
+
+    spacecraft->get_state().set_integrated_state(x.head(time_idx));
+    spacecraft->update(end_time);
+  }
+
+  double propagate_to(const double t)
+  {
+    for (const auto & [scid, sc]: m_spacecrafts) {
+      propagate_to(sc, t);
+    }
+    m_t = t;
+    return m_t;
+  }
+
+  void propagate_by(const std::shared_ptr<spacecraft>& spacecraft, double dt)
+  {
+    propagate_to(spacecraft, m_t + dt);
+  }
+
+  double propagate_by(const double dt)
+  {
+    return propagate_to(m_t + dt);
+  }
+};
+}
+
+#endif //REGULARIZED_PROPAGATOR_H
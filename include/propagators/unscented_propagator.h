@@ -0,0 +1,200 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef UNSCENTED_PROPAGATOR_H
+#define UNSCENTED_PROPAGATOR_H
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+#include <fmt/core.h>
+
+#include "numerical_propagator.h"
+
+namespace naomi::numeric
+{
+
+/**
+ * Tuning parameters of the unscented transform, see Wan and van der Merwe,
+ * "The Unscented Kalman Filter for Nonlinear Estimation".
+ */
+struct unscented_parameters
+{
+  double alpha = 1.0;
+  double beta = 2.0;
+  double kappa = 0.0;
+};
+
+/**
+ * Mean and covariance of the translational state recombined from the sigma
+ * points at a given epoch.
+ */
+struct unscented_estimate
+{
+  double t;
+  arma::vec6 mean;
+  arma::mat66 covariance;
+};
+
+/**
+ * Propagates the covariance of a spacecraft position and velocity with the
+ * unscented transform.
+ *
+ * The 2n+1 sigma points are instantiated as spacecraft and split across a
+ * number of `numerical_propagator` workers that are run concurrently.  All of
+ * the workers share the same `equations_of_motion` instance, and with it the
+ * central body and its compiled potential kernels.  Only the translational
+ * state is perturbed; sigma points carry no attitude dynamics and no maneuver
+ * plan.
+ *
+ * @tparam Stepper The stepper used by each `numerical_propagator` worker
+ */
+template <typename Stepper>
+class unscented_covariance_propagator
+{
+  static constexpr std::size_t N = 6;
+
+  std::shared_ptr<equations_of_motion> _system_eoms;
+  std::vector<std::shared_ptr<spacecraft>> m_sigma_points;
+  std::vector<numerical_propagator<Stepper>> m_workers;
+  arma::vec m_mean_weights;
+  arma::vec m_cov_weights;
+  double m_t = 0.0;
+
+  static std::size_t default_worker_count(const std::size_t n_points)
+  {
+    const std::size_t n_threads =
+        std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    return std::min(n_threads, n_points);
+  }
+
+public:
+  /**
+   * @brief Generate the sigma points from a spacecraft state and covariance.
+   *
+   * @param sc The spacecraft whose current state is the mean of the
+   * distribution
+   * @param covariance 6x6 covariance of the position and velocity
+   * @param system_eoms Equations of motion shared by all sigma points
+   * @param params Unscented transform parameters
+   * @param n_workers Number of concurrent propagators, 0 selects one per
+   * hardware thread
+   */
+  unscented_covariance_propagator(
+      const std::shared_ptr<spacecraft>& sc,
+      const arma::mat66& covariance,
+      const std::shared_ptr<equations_of_motion>& system_eoms,
+      const unscented_parameters& params = {},
+      std::size_t n_workers = 0)
+      : _system_eoms(system_eoms)
+  {
+    constexpr double n = N;
+    const double lambda = pow(params.alpha, 2) * (n + params.kappa) - n;
+
+    arma::mat66 sqrt_cov;
+    if (!arma::chol(sqrt_cov, (n + lambda) * covariance, "lower")) {
+      throw std::runtime_error(
+        "Sigma point covariance is not positive definite");
+    }
+
+    const std::size_t n_points = 2 * N + 1;
+    m_mean_weights = arma::vec(n_points).fill(1.0 / (2 * (n + lambda)));
+    m_cov_weights = m_mean_weights;
+    m_mean_weights[0] = lambda / (n + lambda);
+    m_cov_weights[0] = m_mean_weights[0] + (1 - pow(params.alpha, 2) + params.beta);
+
+    const auto mass = sc->get_state().get_mass();
+    const arma::vec6 mean =
+        sc->get_pv_coordinates().to_vec()(arma::span(0, 5));
+    std::vector<vector_type> points = {mean};
+    for (std::size_t i = 0; i < N; i++) {
+      points.emplace_back(mean + sqrt_cov.col(i));
+    }
+    for (std::size_t i = 0; i < N; i++) {
+      points.emplace_back(mean - sqrt_cov.col(i));
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+      m_sigma_points.push_back(std::make_shared<spacecraft>(
+          fmt::format("{}_sigma_{}", sc->get_identifier(), i), points[i], mass));
+    }
+
+    if (n_workers == 0) n_workers = default_worker_count(n_points);
+    n_workers = std::min(n_workers, n_points);
+    std::vector<std::map<std::string, std::shared_ptr<spacecraft>>> partitions(n_workers);
+    for (std::size_t i = 0; i < m_sigma_points.size(); i++) {
+      const auto& point = m_sigma_points[i];
+      partitions[i % n_workers][point->get_identifier()] = point;
+    }
+    m_workers.resize(n_workers);
+    for (std::size_t i = 0; i < n_workers; i++) {
+      m_workers[i].initialize(_system_eoms, partitions[i]);
+    }
+  }
+
+  [[nodiscard]] auto get_sigma_points() const
+      -> const std::vector<std::shared_ptr<spacecraft>>&
+  {
+    return m_sigma_points;
+  }
+
+  /**
+   * Recombine the mean and covariance from the current sigma points.
+   *
+   * @return The estimate at the current time
+   */
+  [[nodiscard]] auto get_estimate() const -> unscented_estimate
+  {
+    arma::mat states(N, m_sigma_points.size());
+    for (std::size_t i = 0; i < m_sigma_points.size(); i++) {
+      states.col(i) = m_sigma_points[i]->get_pv_coordinates().to_vec()(arma::span(0, 5));
+    }
+    const arma::vec6 mean = states * m_mean_weights;
+    const arma::mat deviations = states.each_col() - mean;
+    const arma::mat66 covariance =
+        deviations * arma::diagmat(m_cov_weights) * deviations.t();
+    return {m_t, mean, covariance};
+  }
+
+  /**
+   * Propagate all sigma points to the given time concurrently.
+   *
+   * @param t The time to propagate to
+   * @return The recombined estimate at `t`
+   */
+  auto propagate_to(const double t) -> unscented_estimate
+  {
+    std::vector<std::future<double>> results;
+    results.reserve(m_workers.size());
+    for (auto& worker : m_workers) {
+      results.push_back(std::async(std::launch::async,
+        [&worker, t]() { return worker.propagate_to(t); }));
+    }
+    for (auto& result : results) {
+      result.get();
+    }
+    m_t = t;
+    return get_estimate();
+  }
+
+  /**
+   * Propagate through a sequence of output epochs, recombining the
+   * distribution at each of them.
+   *
+   * @param epochs Increasing output epochs
+   * @return One estimate per epoch
+   */
+  auto propagate(const std::vector<double>& epochs) -> std::vector<unscented_estimate>
+  {
+    std::vector<unscented_estimate> estimates;
+    estimates.reserve(epochs.size());
+    for (const double t : epochs) {
+      estimates.push_back(propagate_to(t));
+    }
+    return estimates;
+  }
+};
+}
+
+#endif //UNSCENTED_PROPAGATOR_H
@@ -4,7 +4,13 @@
 
 #ifndef SIMULATION_H
 #define SIMULATION_H
+#include <functional>
+#include <optional>
+#include <queue>
+
 #include "observers/simulation_observer.h"
+#include "propagators/propagation_stats.h"
+#include "simulation/tracing.h"
 
 namespace naomi
 {
@@ -26,41 +32,95 @@ class simulation
   std::shared_ptr<system_t> m_system;
   std::vector<std::shared_ptr<simulation_observer<system_t>>> m_observers;
   double m_t = 0;
+  numeric::propagation_stats m_stats;
+  std::string m_trace_path;
 
 public:
   explicit simulation(std::shared_ptr<system_t> system): m_system(system){}
   simulation(std::shared_ptr<system_t> system, const std::initializer_list<std::shared_ptr<simulation_observer<system_t>>>& observers):
     m_system(system), m_observers(observers){}
 
-  std::pair<double, std::shared_ptr<simulation_observer<system_t>>> get_next_update()
+  /**
+   * Observers are observed in order of their next update time, each entry is
+   * the time and the index of the observer.
+   */
+  typedef std::pair<double, std::size_t> scheduled_update;
+  typedef std::priority_queue<scheduled_update, std::vector<scheduled_update>, std::greater<>> update_queue;
+
+  /**
+   * @return The time of the earliest observer update, nothing without
+   * observers
+   */
+  [[nodiscard]] std::optional<double> get_next_update() const
   {
-    if (m_observers.empty()) {
-      return {0, nullptr};
+    std::optional<double> next;
+    for (const auto& observer: m_observers) {
+      if (! next || observer->get_next_update() < *next) next = observer->get_next_update();
     }
-    auto obs = m_observers.at(0);
-    return {obs->get_next_update(), obs};
+    return next;
   }
 
-  void simulate(const double duration)
+  /**
+   * Simulate the system up to `end_time`.  The system stops only at the
+   * update times of the observers, observers due at the same time share a
+   * single stop.
+   *
+   * @param end_time The simulation end time
+   */
+  void simulate(const double end_time)
   {
+    NAOMI_TRACE_SCOPE("simulation::simulate");
     for(const auto& observer: m_observers) observer->initialize(m_system);
 
-    while (m_t < duration)
-    {
-      auto next_update = get_next_update();
-      double interval = 0;
-      if (next_update.second == nullptr) {
-        interval = m_t + duration;
-      } else {
-        interval = next_update.first;
+    update_queue updates;
+    for (std::size_t i = 0; i < m_observers.size(); i++) {
+      updates.emplace(m_observers[i]->get_next_update(), i);
+    }
+
+    while (true) {
+      while (! updates.empty() && updates.top().first <= m_t) {
+        const std::size_t i = updates.top().second;
+        updates.pop();
+        {
+          NAOMI_STATS(const numeric::scoped_stats_timer timer(m_stats.observer_time);)
+          NAOMI_STATS(m_stats.observer_callbacks++;)
+          NAOMI_TRACE_SCOPE("observe_state");
+          m_observers[i]->observe_state(m_system);
+        }
+        updates.emplace(m_observers[i]->get_next_update(), i);
       }
-      const double curr_time = m_system->simulate_to(interval);
-      if (next_update.second != nullptr) {
-        next_update.second->observe_state(m_system);
+      if (m_t >= end_time) {
+        break;
       }
-      m_t = curr_time;
+      const double next_stop = updates.empty() ? end_time : std::min(updates.top().first, end_time);
+      m_t = m_system->simulate_to(next_stop);
     }
     for(const auto& observer: m_observers) observer->terminate(m_system);
+    if (! m_trace_path.empty()) {
+      tracing::write_chrome_trace(m_trace_path);
+    }
+  }
+
+  /**
+   * Record the simulation phases and write them as Chrome trace JSON (opens
+   * in Perfetto) to `filepath` at the end of `simulate`.  Requires a build
+   * with NAOMI_ENABLE_TRACING, the trace is empty otherwise.
+   *
+   * @param filepath Path of the trace file, overwritten
+   */
+  void set_trace_output(const std::string& filepath)
+  {
+    m_trace_path = filepath;
+    tracing::set_enabled(true);
+  }
+
+  /**
+   * @return The number and time of the observer callbacks, all zero unless
+   * built with NAOMI_ENABLE_STATS, see the propagator for the integration
+   */
+  [[nodiscard]] const numeric::propagation_stats& get_stats() const
+  {
+    return m_stats;
   }
 };
 }
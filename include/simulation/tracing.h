@@ -0,0 +1,237 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+/**
+ * Scoped tracing of the simulation phases is only compiled in with
+ * NAOMI_ENABLE_TRACING=1 (CMake option NAOMI_ENABLE_TRACING), otherwise every
+ * `NAOMI_TRACE_SCOPE(...)` compiles to nothing.  When compiled in, nothing
+ * is recorded until `tracing::set_enabled(true)`.
+ */
+#ifndef NAOMI_ENABLE_TRACING
+#define NAOMI_ENABLE_TRACING 0
+#endif
+
+#define NAOMI_TRACE_CONCAT_IMPL(a, b) a##b
+#define NAOMI_TRACE_CONCAT(a, b) NAOMI_TRACE_CONCAT_IMPL(a, b)
+
+#if NAOMI_ENABLE_TRACING
+#define NAOMI_TRACE_SCOPE(...) \
+  const naomi::tracing::scoped_trace NAOMI_TRACE_CONCAT(naomi_trace_scope_, __LINE__)(__VA_ARGS__)
+#else
+#define NAOMI_TRACE_SCOPE(...)
+#endif
+
+namespace naomi::tracing
+{
+/**
+ * A completed scope, times are microseconds since the start of the process'
+ * trace clock.
+ */
+struct trace_event
+{
+  /// Static string naming the phase
+  const char* name;
+  /// Optional detail, e.g. the spacecraft identifier
+  std::string detail;
+  double start;
+  double duration;
+};
+
+/**
+ * The events recorded by one thread.  Only the owning thread appends to it,
+ * the buffer is read when the trace is written after the run.
+ */
+struct thread_buffer
+{
+  std::uint32_t tid;
+  std::vector<trace_event> events;
+};
+
+/**
+ * Process wide registry of the thread buffers.  A thread registers its buffer
+ * under the lock once, on its first event; recording itself is a plain append
+ * to the thread's own buffer.
+ */
+class tracer
+{
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<thread_buffer>> m_buffers;
+  std::atomic<bool> m_enabled = false;
+  std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+
+  static void write_escaped(std::ofstream& out, const std::string& s)
+  {
+    for (const char c: s) {
+      if (c == '"' || c == '\\') out.put('\\');
+      out.put(c);
+    }
+  }
+
+public:
+  static tracer& instance()
+  {
+    static tracer t;
+    return t;
+  }
+
+  [[nodiscard]] bool is_enabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  void set_enabled(const bool enabled)
+  {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return Microseconds since the trace clock started
+   */
+  [[nodiscard]] double now() const
+  {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_epoch).count();
+  }
+
+  /**
+   * @return The buffer of the calling thread
+   */
+  thread_buffer& local_buffer()
+  {
+    thread_local std::shared_ptr<thread_buffer> buffer = [this]
+    {
+      const std::lock_guard lock(m_mutex);
+      auto b = std::make_shared<thread_buffer>();
+      b->tid = static_cast<std::uint32_t>(m_buffers.size());
+      m_buffers.push_back(b);
+      return b;
+    }();
+    return *buffer;
+  }
+
+  void record(const char* name, std::string detail, const double start, const double end)
+  {
+    local_buffer().events.push_back({name, std::move(detail), start, end - start});
+  }
+
+  /**
+   * Drops the recorded events of every thread.  Call while no thread is
+   * recording.
+   */
+  void clear()
+  {
+    const std::lock_guard lock(m_mutex);
+    for (const auto& buffer: m_buffers) {
+      buffer->events.clear();
+    }
+  }
+
+  /**
+   * @return The number of recorded events of all threads
+   */
+  [[nodiscard]] std::size_t size()
+  {
+    const std::lock_guard lock(m_mutex);
+    std::size_t n = 0;
+    for (const auto& buffer: m_buffers) {
+      n += buffer->events.size();
+    }
+    return n;
+  }
+
+  /**
+   * Writes the recorded events as Chrome trace JSON (complete "X" events),
+   * which opens in Perfetto or chrome://tracing.  Call once the threads that
+   * recorded have finished, i.e. after the run.
+   *
+   * @param filepath Path of the JSON file, overwritten
+   */
+  void write_chrome_trace(const std::string& filepath)
+  {
+    std::ofstream out(filepath);
+    if (! out) {
+      throw std::runtime_error(fmt::format("Unable to open {} for writing", filepath));
+    }
+    const std::lock_guard lock(m_mutex);
+    out << R"({"displayTimeUnit": "ms", "traceEvents": [)";
+    bool first = true;
+    for (const auto& buffer: m_buffers) {
+      for (const trace_event& e: buffer->events) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << fmt::format(R"({{"name": "{}", "cat": "naomi", "ph": "X", "pid": 0, "tid": {}, "ts": {:.3f}, "dur": {:.3f})",
+                           e.name, buffer->tid, e.start, e.duration);
+        if (! e.detail.empty()) {
+          out << R"(, "args": {"detail": ")";
+          write_escaped(out, e.detail);
+          out << "\"}";
+        }
+        out << "}";
+      }
+    }
+    out << "\n]}\n";
+  }
+};
+
+/**
+ * Records the time from its construction to its destruction as an event of
+ * the calling thread, if tracing is enabled at construction.
+ */
+class scoped_trace
+{
+  const char* m_name;
+  std::string m_detail;
+  double m_start = -1.0;
+
+public:
+  /**
+   * @param name Static string naming the phase
+   * @param detail Optional detail shown with the event
+   */
+  explicit scoped_trace(const char* name, std::string detail = {}): m_name(name)
+  {
+    tracer& t = tracer::instance();
+    if (t.is_enabled()) {
+      m_detail = std::move(detail);
+      m_start = t.now();
+    }
+  }
+  scoped_trace(const scoped_trace&) = delete;
+  scoped_trace& operator=(const scoped_trace&) = delete;
+
+  ~scoped_trace()
+  {
+    if (m_start >= 0.0) {
+      tracer& t = tracer::instance();
+      t.record(m_name, std::move(m_detail), m_start, t.now());
+    }
+  }
+};
+
+inline void set_enabled(const bool enabled)
+{
+  tracer::instance().set_enabled(enabled);
+}
+
+inline void write_chrome_trace(const std::string& filepath)
+{
+  tracer::instance().write_chrome_trace(filepath);
+}
+}
+
+#endif //TRACING_H
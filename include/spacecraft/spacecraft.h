@@ -14,6 +14,7 @@
 #include "maneuvers/maneuver_plan.h"
 #include "pv_coordinates.h"
 #include "pv_coordinates_provider.h"
+#include "stm_provider.h"
 
 namespace naomi {
 
@@ -62,6 +63,25 @@ public:
     _attitude_provider(std::make_shared<constant_attitude_provider>()),
     m_maneuver_plan(mp) {}
 
+  /**
+   * Construct a spacecraft from a custom state provider, e.g. one that
+   * integrates additional quantities such as the state transition matrix.
+   *
+   * @param identifier Unique identifier of the spacecraft
+   * @param state_provider Provider of the translational state
+   * @param mass Mass of the spacecraft in kg
+   * @param mp Optional maneuver plan
+   */
+  spacecraft(std::string identifier,
+             const std::shared_ptr<state_provider>& state_provider,
+             const double& mass,
+             const std::shared_ptr<maneuvers::maneuver_plan>& mp = nullptr):
+    m_identifier(std::move(identifier)),
+    m_pv_coordinates(state_provider->get_pv_coordinates()),
+    _attitude_provider(std::make_shared<constant_attitude_provider>()),
+    m_maneuver_plan(mp),
+    _state(state_provider, _attitude_provider, mass){}
+
   auto get_state() -> spacecraft_state
   {
     return _state;
@@ -71,6 +71,11 @@ public:
     return _attitude_provider;
   }
 
+  [[nodiscard]] double get_mass() const
+  {
+    return _mass;
+  }
+
   std::vector<std::pair<arma::span, std::shared_ptr<integrated_provider>>> get_provider_mapping()
   {
     auto integrated_providers = get_integrated_providers();
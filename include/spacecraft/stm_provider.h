@@ -0,0 +1,93 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef STM_PROVIDER_H
+#define STM_PROVIDER_H
+#include "forces/variational_equations.h"
+#include "state_provider.h"
+
+using namespace naomi;
+
+/**
+ * State provider that integrates the 6x6 state transition matrix alongside
+ * the position and velocity of the spacecraft.
+ *
+ * Unlike `pv_coordinates_provider` this provider owns its equations of
+ * motion (`variational_eoms`) since the system equations of motion only
+ * know about the 9 element position/velocity/acceleration state.
+ */
+class stm_provider final
+    :
+  public state_provider,
+  public integrated_provider
+{
+  pv_coordinates _state;
+  arma::mat66 _stm = arma::eye(6, 6);
+  std::shared_ptr<naomi::forces::equations_of_motion> _eoms;
+
+public:
+  stm_provider(pv_coordinates initial_state,
+               const std::shared_ptr<naomi::bodies::celestial_body>& central_body):
+    _state(std::move(initial_state)),
+    _eoms(std::make_shared<naomi::forces::variational_eoms>(central_body)){}
+  ~stm_provider() override = default;
+
+  pv_coordinates get_pv_coordinates() override { return _state; }
+
+  /**
+   * The state transition matrix from the epoch of the last reset to the
+   * current state.
+   *
+   * @return Phi(t, t0) copied by value
+   */
+  [[nodiscard]] auto get_stm() const -> arma::mat66
+  {
+    return _stm;
+  }
+
+  /**
+   * Restart the accumulation of the state transition matrix from the current
+   * state, e.g. at the start of a new targeting arc.
+   */
+  void reset_stm()
+  {
+    _stm.eye();
+  }
+
+  vector_type get_integrated_state() override
+  {
+    vector_type state(get_size());
+    state(arma::span(0, 8)) = _state.to_vec();
+    state(arma::span(naomi::forces::variational_eoms::STM_OFFSET, get_size() - 1)) =
+        arma::vectorise(_stm);
+    return state;
+  }
+
+  std::size_t get_size() override
+  {
+    return naomi::forces::variational_eoms::STATE_SIZE;
+  }
+
+  void set_integrated_state(const vector_type& state) override
+  {
+    _state = pv_coordinates(vector_type(state(arma::span(0, 8))));
+    _stm = arma::reshape(
+        state(arma::span(naomi::forces::variational_eoms::STM_OFFSET, get_size() - 1)),
+        6, 6);
+  }
+
+  std::shared_ptr<forces::equations_of_motion> get_eoms() override
+  {
+    return _eoms;
+  }
+
+  void apply_control(const vector_type& control) override
+  {
+    // Impulsive controls do not depend on the state, the STM is unchanged
+    const vector_type updated_state = _state.to_vec() + control;
+    _state = pv_coordinates(updated_state);
+  }
+};
+
+#endif //STM_PROVIDER_H
@@ -5,9 +5,12 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include <spacecraft/spacecraft.h>
 #include "forces/force_model.h"
+#include "simulation/tracing.h"
 #include <fmt/core.h>
 
 namespace naomi
@@ -34,6 +37,28 @@ class physical_system
   // A system is made up of a central body and some number of additional perturbing bodies
   // It can have one or many spacecraft
   // fidelity defined at the system level
+
+  void insert(std::shared_ptr<spacecraft> s)
+  {
+    std::string identifier = s->get_identifier();
+    m_spacecrafts.insert_or_assign(std::move(identifier), std::move(s));
+  }
+
+  void insert(const spacecraft& s)
+  {
+    insert(std::make_shared<spacecraft>(s));
+  }
+
+  void insert(spacecraft&& s)
+  {
+    insert(std::make_shared<spacecraft>(std::move(s)));
+  }
+
+  void insert(const std::pair<const std::string, std::shared_ptr<spacecraft>>& s)
+  {
+    insert(s.second);
+  }
+
 public:
   /**
    * @brief
@@ -60,7 +85,7 @@ public:
     _system_eoms(system_eoms)
   {
     for (const spacecraft& s: spacecrafts) {
-      m_spacecrafts[s.get_identifier()] = std::make_shared<spacecraft>(s);
+      insert(s);
     }
     m_propagator.initialize(_system_eoms, m_spacecrafts);
   }
@@ -74,7 +99,33 @@ public:
   _system_eoms(system_eoms)
   {
     for (const std::shared_ptr<spacecraft>& s: spacecrafts) {
-      m_spacecrafts[s->get_identifier()] = s;
+      insert(s);
+    }
+    m_propagator.initialize(_system_eoms, m_spacecrafts);
+  }
+
+  /**
+   * @brief Construct from any range of spacecraft, shared pointers to
+   * spacecraft or (identifier, spacecraft) map entries, e.g. the output of
+   * `walker_constellation::make_spacecraft`.
+   *
+   * Shared pointers are stored as they are, so a range of them adds no copies
+   * of the spacecraft.  Spacecraft in a range passed as an rvalue are moved
+   * into the system, otherwise copied.
+   *
+   * @param spacecrafts The spacecraft of the system
+   * @param system_eoms Equations of motion for spacecraft without their own
+   */
+  template <typename Range, typename = decltype(std::begin(std::declval<Range&>()))>
+  physical_system(Range&& spacecrafts, const std::shared_ptr<equations_of_motion>& system_eoms):
+  _system_eoms(system_eoms)
+  {
+    for (auto& s: spacecrafts) {
+      if constexpr (std::is_lvalue_reference_v<Range>) {
+        insert(s);
+      } else {
+        insert(std::move(s));
+      }
     }
     m_propagator.initialize(_system_eoms, m_spacecrafts);
   }
@@ -107,6 +158,14 @@ public:
     return m_t;
   }
 
+  /**
+   * @return The propagator, e.g. for its statistics
+   */
+  auto get_propagator() -> Propagator&
+  {
+    return m_propagator;
+  }
+
   /**
    * @brief
    * @param dt
@@ -124,6 +183,7 @@ public:
   double simulate_to(double dt)
   {
     // fmt::print("Simulating to: {}\n", dt);
+    NAOMI_TRACE_SCOPE("physical_system::simulate_to");
     m_t = m_propagator.propagate_to(dt);
     return m_t;
   }
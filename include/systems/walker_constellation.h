@@ -0,0 +1,152 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef WALKER_CONSTELLATION_H
+#define WALKER_CONSTELLATION_H
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <armadillo>
+#include <fmt/core.h>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "constants.h"
+#include "orbits/orbit_batch.h"
+#include "spacecraft/spacecraft.h"
+
+namespace naomi
+{
+enum class walker_pattern
+{
+  /// Planes spread over 360 deg of right ascension
+  DELTA,
+  /// Planes spread over 180 deg of right ascension, e.g. polar constellations
+  STAR
+};
+
+/**
+ * Walker constellation i:t/p/f, `t` spacecraft on circular orbits in `p`
+ * equally spaced planes of inclination `i`, `t / p` equally spaced in each
+ * plane, with the spacecraft of neighbouring planes shifted by
+ * f * 360 deg / t along the orbit.
+ */
+class walker_constellation
+{
+  walker_pattern m_pattern;
+  double m_sma;
+  double m_inc;
+  std::size_t m_total;
+  std::size_t m_planes;
+  std::size_t m_phasing;
+  double m_mu;
+
+public:
+  /**
+   * @param pattern Delta or star spacing of the planes
+   * @param sma Radius of the orbits in meters
+   * @param inc Inclination of the planes in radians
+   * @param total Number of spacecraft t, a multiple of the number of planes
+   * @param planes Number of planes p
+   * @param phasing Phasing parameter f in [0, p)
+   * @param mu Gravitational parameter of the central body
+   */
+  walker_constellation(const walker_pattern pattern,
+                       const double sma,
+                       const double inc,
+                       const std::size_t total,
+                       const std::size_t planes,
+                       const std::size_t phasing,
+                       const double mu = constants::EARTH_MU)
+      : m_pattern(pattern), m_sma(sma), m_inc(inc), m_total(total), m_planes(planes), m_phasing(phasing), m_mu(mu)
+  {
+    if (planes == 0 || total % planes != 0) {
+      throw std::runtime_error(fmt::format("Walker constellation of {} spacecraft can't be split into {} planes", total, planes));
+    }
+    if (phasing >= planes) {
+      throw std::runtime_error(fmt::format("Walker phasing must be less than the {} planes, got {}", planes, phasing));
+    }
+  }
+
+  /**
+   * @return Elements of every spacecraft, plane by plane
+   */
+  [[nodiscard]] auto get_elements() const -> orbits::keplerian_batch
+  {
+    constexpr double two_pi = boost::math::double_constants::two_pi;
+    const std::size_t per_plane = m_total / m_planes;
+    const double raan_spread = m_pattern == walker_pattern::DELTA ? two_pi : two_pi / 2;
+    orbits::keplerian_batch elements(m_total);
+    for (std::size_t plane = 0; plane < m_planes; plane++) {
+      for (std::size_t slot = 0; slot < per_plane; slot++) {
+        const std::size_t i = plane * per_plane + slot;
+        const double anomaly = two_pi * static_cast<double>(slot) / static_cast<double>(per_plane)
+            + two_pi * static_cast<double>(m_phasing * plane) / static_cast<double>(m_total);
+        elements.sma[i] = m_sma;
+        elements.ecc[i] = 0.0;
+        elements.inc[i] = m_inc;
+        elements.raan[i] = raan_spread * static_cast<double>(plane) / static_cast<double>(m_planes);
+        elements.aop[i] = 0.0;
+        elements.ma[i] = anomaly - two_pi * std::floor(anomaly / two_pi);
+      }
+    }
+    return elements;
+  }
+
+  /**
+   * @return Cartesian states of every spacecraft, plane by plane
+   */
+  [[nodiscard]] auto get_states() const -> orbits::cartesian_batch
+  {
+    return orbits::keplerian_to_cartesian(get_elements(), m_mu);
+  }
+
+  /**
+   * Create the spacecraft of the constellation, identified by
+   * "<prefix>-<plane>-<slot>".  Pass the result to the range constructor of
+   * `physical_system`, which stores the pointers without copying the
+   * spacecraft.
+   *
+   * @param mass Mass of every spacecraft in kg
+   * @param prefix Prefix of the identifiers
+   */
+  [[nodiscard]] auto make_spacecraft(const double mass, const std::string& prefix = "sat") const
+      -> std::vector<std::shared_ptr<spacecraft>>
+  {
+    const orbits::cartesian_batch states = get_states();
+    const std::size_t per_plane = m_total / m_planes;
+    std::vector<std::shared_ptr<spacecraft>> spacecrafts;
+    spacecrafts.reserve(m_total);
+    vector_type state(6);
+    for (std::size_t i = 0; i < m_total; i++) {
+      state = {states.x[i], states.y[i], states.z[i], states.vx[i], states.vy[i], states.vz[i]};
+      spacecrafts.push_back(std::make_shared<spacecraft>(
+          fmt::format("{}-{}-{}", prefix, i / per_plane, i % per_plane), state, mass));
+    }
+    return spacecrafts;
+  }
+
+  [[nodiscard]] auto get_total() const -> std::size_t
+  {
+    return m_total;
+  }
+
+  [[nodiscard]] auto get_planes() const -> std::size_t
+  {
+    return m_planes;
+  }
+
+  [[nodiscard]] auto get_phasing() const -> std::size_t
+  {
+    return m_phasing;
+  }
+};
+}
+
+#endif //WALKER_CONSTELLATION_H
@@ -0,0 +1,83 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+// Replacement of the global operator new and delete counting the heap
+// allocations per thread (see profiling/allocation_counter.h).  Only linked
+// into the test and benchmark targets with NAOMI_COUNT_ALLOCATIONS on.
+
+#include <cstdlib>
+#include <new>
+
+#include "profiling/allocation_counter.h"
+
+namespace
+{
+using naomi::profiling::detail::thread_counts;
+
+void* counted_malloc(const std::size_t size) noexcept
+{
+  thread_counts.allocations++;
+  thread_counts.bytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* counted_aligned_alloc(const std::size_t size, const std::align_val_t alignment) noexcept
+{
+  thread_counts.allocations++;
+  thread_counts.bytes += size;
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment
+  const std::size_t padded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+  return std::aligned_alloc(align, padded);
+}
+
+void counted_free(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  thread_counts.deallocations++;
+  std::free(p);
+}
+
+void* allocate_or_throw(const std::size_t size)
+{
+  void* p = counted_malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* aligned_allocate_or_throw(const std::size_t size, const std::align_val_t alignment)
+{
+  void* p = counted_aligned_alloc(size, alignment);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+}
+
+void* operator new(const std::size_t size) { return allocate_or_throw(size); }
+void* operator new[](const std::size_t size) { return allocate_or_throw(size); }
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void* operator new(const std::size_t size, const std::align_val_t alignment) { return aligned_allocate_or_throw(size, alignment); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment) { return aligned_allocate_or_throw(size, alignment); }
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_aligned_alloc(size, alignment); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_aligned_alloc(size, alignment); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free(p); }
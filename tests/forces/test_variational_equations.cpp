@@ -0,0 +1,75 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "forces/variational_equations.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "spacecraft/stm_provider.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+TEST(TestVariationalEquations, HessianMatchesFiniteDifference)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  arma::vec pos = {3900000.0, 3900000.0, 3900000.0};
+  const auto [partial, hessian] = earth_body->get_potential_partial_and_hessian(pos);
+
+  const arma::vec expected_partial = earth_body->get_potential_partial(pos);
+  EXPECT_TRUE(arma::approx_equal(partial, expected_partial, "reldiff", 1e-12));
+
+  constexpr double h = 1.0;
+  for (arma::uword i = 0; i < 3; i++) {
+    arma::vec plus = pos;
+    arma::vec minus = pos;
+    plus[i] += h;
+    minus[i] -= h;
+    const arma::vec column = (earth_body->get_potential_partial(plus)
+        - earth_body->get_potential_partial(minus)) / (2 * h);
+    EXPECT_TRUE(arma::approx_equal(hessian.col(i), column, "reldiff", 1e-6));
+  }
+}
+
+TEST(TestVariationalEquations, StmMatchesFiniteDifference)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const vector_type pv = get_circular_orbit({6878000.0, 0.0, 0.0});
+  const auto eoms = std::make_shared<variational_eoms>(earth_body);
+  const auto two_body = std::make_shared<two_body_force_model_eoms>(earth_body);
+
+  stm_provider provider(pv_coordinates(pv), earth_body);
+  vector_type augmented = provider.get_integrated_state();
+  integrator<rk_dopri5_stepper> integ;
+  const system_t augmented_system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+  integ.integrate(augmented_system, augmented, 0.0, 600.0, 0.1);
+  provider.set_integrated_state(augmented);
+  const arma::mat66 stm = provider.get_stm();
+
+  const system_t system = [two_body](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = two_body->get_derivative(x, t);
+  };
+  vector_type nominal = pv_coordinates(pv).to_vec();
+  integ.integrate(system, nominal, 0.0, 600.0, 0.1);
+
+  // Perturb the initial position along x and compare against the first column
+  constexpr double dx = 10.0;
+  vector_type perturbed = pv_coordinates(pv).to_vec();
+  perturbed[0] += dx;
+  integ.integrate(system, perturbed, 0.0, 600.0, 0.1);
+  const arma::vec6 column = (perturbed.subvec(0, 5) - nominal.subvec(0, 5)) / dx;
+  EXPECT_TRUE(arma::approx_equal(stm.col(0), column, "absdiff", 1e-3));
+}
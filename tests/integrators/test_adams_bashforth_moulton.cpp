@@ -0,0 +1,84 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "integrators/adams_bashforth_moulton.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+namespace
+{
+system_t make_two_body_system()
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  return [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+}
+}
+
+TEST(TestAdamsBashforthMoulton, ClosesCircularOrbit)
+{
+  const system_t system = make_two_body_system();
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  const double period = keplerian_orbit::get_orbital_period(6878000.0);
+
+  integrator<adams_bashforth_moulton_stepper<>> integ(adams_bashforth_moulton_stepper<>(1e-10, 1e-10));
+  vector_type state = initial;
+  integ.integrate(system, state, 0.0, period, 1.0);
+
+  EXPECT_LT(arma::norm(state.subvec(0, 2) - initial.subvec(0, 2)), 1.0);
+}
+
+TEST(TestAdamsBashforthMoulton, RestartsAfterDiscontinuity)
+{
+  const system_t system = make_two_body_system();
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  const arma::vec3 dv = {0, 100, 0};
+
+  // Integrate, apply an impulse without resetting and continue
+  integrator<adams_bashforth_moulton_stepper<>> integ(adams_bashforth_moulton_stepper<>(1e-10, 1e-10));
+  vector_type state = initial;
+  integ.integrate(system, state, 0.0, 1000.0, 1.0);
+  vector_type restarted_from = state;
+  restarted_from.subvec(3, 5) += dv;
+  state = restarted_from;
+  integ.integrate(system, state, 1000.0, 3000.0, 1.0);
+
+  // The same arc integrated from scratch
+  integrator<adams_bashforth_moulton_stepper<>> fresh(adams_bashforth_moulton_stepper<>(1e-10, 1e-10));
+  vector_type expected = restarted_from;
+  fresh.integrate(system, expected, 1000.0, 3000.0, 1.0);
+
+  EXPECT_LT(arma::norm(state.subvec(0, 2) - expected.subvec(0, 2)), 1.0);
+}
+
+TEST(TestAdamsBashforthMoulton, RejectsBackwardInterval)
+{
+  const system_t system = make_two_body_system();
+  vector_type state(9, arma::fill::zeros);
+  state(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+
+  integrator<adams_bashforth_moulton_stepper<>> integ(adams_bashforth_moulton_stepper<>(1e-10, 1e-10));
+  EXPECT_THROW(integ.integrate(system, state, 1000.0, 0.0, 1.0), std::runtime_error);
+  EXPECT_THROW(integ.integrate_steps(system, state, 1000.0, 0.0, 1.0,
+                                     [](double, double, const step_interpolator_t&) { return std::optional<double>(); }),
+               std::runtime_error);
+}
@@ -0,0 +1,122 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "integrators/symplectic.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+namespace
+{
+template <typename Stepper>
+vector_type propagate_orbit(Stepper stepper, const vector_type& initial, const double duration)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const system_t system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+  integrator<Stepper> integ(stepper);
+  vector_type state = initial;
+  integ.integrate(system, state, 0.0, duration, stepper.get_step_size());
+  return state;
+}
+}
+
+TEST(TestSymplectic, KeplerPropagateClosesOrbit)
+{
+  const arma::vec3 r0 = {7000000.0, 0, 0};
+  const arma::vec3 v0 = {0, 8000.0, 1000.0};
+  const double sma = 1 / (2 / norm(r0) - dot(v0, v0) / constants::EARTH_MU);
+  const pv_state_type pv = kepler_propagate(r0, v0, keplerian_orbit::get_orbital_period(sma));
+  EXPECT_LT(arma::norm(pv.subvec(0, 2) - r0), 1e-3);
+  EXPECT_LT(arma::norm(pv.subvec(3, 5) - v0), 1e-6);
+
+  // Hyperbolic arcs compose
+  const arma::vec3 v_hyp = {0, 12000.0, 0};
+  const pv_state_type full = kepler_propagate(r0, v_hyp, 3000.0);
+  const pv_state_type half = kepler_propagate(r0, v_hyp, 1500.0);
+  const pv_state_type composed = kepler_propagate(half.subvec(0, 2), half.subvec(3, 5), 1500.0);
+  EXPECT_LT(arma::norm(full.subvec(0, 2) - composed.subvec(0, 2)), 1e-3);
+}
+
+TEST(TestSymplectic, YoshidaFourthOrderConvergence)
+{
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  const double period = keplerian_orbit::get_orbital_period(6878000.0);
+
+  // Richardson style estimate, the error of each step halving drops by 2^4
+  const vector_type coarse = propagate_orbit(yoshida4_stepper(period / 50), initial, period);
+  const vector_type fine = propagate_orbit(yoshida4_stepper(period / 100), initial, period);
+  const double coarse_error = arma::norm(coarse.subvec(0, 2) - fine.subvec(0, 2));
+  const vector_type finer = propagate_orbit(yoshida4_stepper(period / 200), initial, period);
+  const double fine_error = arma::norm(fine.subvec(0, 2) - finer.subvec(0, 2));
+  EXPECT_NEAR(coarse_error / fine_error, 16.0, 3.0);
+}
+
+TEST(TestSymplectic, WisdomHolmanBoundedEnergy)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  initial(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(initial.subvec(3, 5));
+  const double period = keplerian_orbit::get_orbital_period(6878000.0);
+
+  auto energy = [&earth_body](const vector_type& x)
+  {
+    arma::vec pos = x.subvec(0, 2);
+    return 0.5 * arma::dot(x.subvec(3, 5), x.subvec(3, 5)) + earth_body->get_potential(pos);
+  };
+
+  const vector_type state = propagate_orbit(wisdom_holman_stepper(60.0), initial, 100 * period);
+  EXPECT_LT(std::abs((energy(state) - energy(initial)) / energy(initial)), 1e-6);
+}
+
+TEST(TestSymplectic, RejectsStateBeyondPositionVelocity)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const system_t system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+    dxdt(6) = 1.0;
+  };
+  vector_type state(9, arma::fill::zeros);
+  state(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  integrator<yoshida4_stepper> integ(yoshida4_stepper(60.0));
+  EXPECT_THROW(integ.integrate(system, state, 0.0, 600.0, 60.0), std::runtime_error);
+}
+
+TEST(TestSymplectic, FirstStepIsFixedStep)
+{
+  vector_type initial(9, arma::fill::zeros);
+  initial(arma::span(0, 5)) = get_circular_orbit({6878000.0, 0, 0});
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const system_t system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+
+  // A small initial guess must not shift the grid of fixed steps
+  integrator<yoshida4_stepper> guessed(yoshida4_stepper(60.0));
+  vector_type from_guess = initial;
+  guessed.integrate(system, from_guess, 0.0, 6000.0, 0.1);
+  const vector_type fixed = propagate_orbit(yoshida4_stepper(60.0), initial, 6000.0);
+  EXPECT_LT(arma::norm(from_guess.subvec(0, 2) - fixed.subvec(0, 2)), 1e-6);
+}
@@ -0,0 +1,69 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <limits>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "integrators/taylor_integrator.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+TEST(TestTaylorIntegrator, OrderFromTolerance)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const taylor_integrator loose(earth_body, 1e-9, 1e-9);
+  EXPECT_EQ(loose.get_order(), 20);
+  const taylor_integrator tight(earth_body, 1e-20, 1e-20);
+  EXPECT_GT(tight.get_order(), 20);
+}
+
+TEST(TestTaylorIntegrator, FewerStepsThanDopri5)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const auto eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const vector_type initial = get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  const double duration = 10 * keplerian_orbit::get_orbital_period(norm(initial.subvec(0, 2)));
+  constexpr double tol = 1e-12;
+
+  vector_type dopri_state = initial;
+  const system_t system = [eoms](const vector_type& x, vector_type& dxdt, double t)
+  {
+    dxdt = eoms->get_derivative(x, t);
+  };
+  const auto dopri_steps = boost::numeric::odeint::integrate_adaptive(
+      boost::numeric::odeint::make_controlled(tol, tol, rk_dopri5_stepper()),
+      system, dopri_state, 0.0, duration, 10.0);
+
+  vector_type taylor_state = initial;
+  taylor_integrator taylor(earth_body, tol, tol);
+  const auto taylor_steps = taylor.integrate(taylor_state, 0.0, duration);
+
+  EXPECT_LT(taylor_steps * 10, dopri_steps);
+  EXPECT_LT(arma::norm(taylor_state.subvec(0, 2) - dopri_state.subvec(0, 2)), 1.0);
+}
+
+TEST(TestTaylorIntegrator, RejectsNonFiniteStep)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  taylor_integrator taylor(earth_body, 1e-12, 1e-12);
+  vector_type state = get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  state(0) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(taylor.integrate(state, 0.0, 100.0), std::runtime_error);
+
+  vector_type finite = get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  double t = 0.0;
+  EXPECT_THROW(taylor.do_step(finite, t, 0.0), std::runtime_error);
+}
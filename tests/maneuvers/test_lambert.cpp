@@ -0,0 +1,141 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "constants.h"
+#include "frames/transforms.h"
+#include "maneuvers/hohmann_transfer.h"
+#include "maneuvers/lambert.h"
+#include "maneuvers/porkchop.h"
+#include "orbits/orbits.h"
+
+using namespace naomi;
+using namespace naomi::maneuvers;
+using namespace naomi::orbits;
+
+namespace
+{
+const arma::vec3 r1 = {7000000.0, 1000000.0, -500000.0};
+const arma::vec3 v1 = {-1000.0, 7500.0, 1200.0};
+
+pv_state_type circular_state(const double radius, const double phase)
+{
+  const double speed = std::sqrt(constants::EARTH_MU / radius);
+  return {radius * std::cos(phase), radius * std::sin(phase), 0,
+          -speed * std::sin(phase), speed * std::cos(phase), 0};
+}
+}
+
+TEST(TestLambert, RecoversSingleRevolutionVelocities)
+{
+  for (const double tof : {1500.0, 4000.0}) {
+    const pv_state_type arrival = kepler_propagate(r1, v1, tof);
+    const auto solutions = solve_lambert(r1, arrival.subvec(0, 2), tof);
+    ASSERT_EQ(solutions.size(), 1u);
+    EXPECT_EQ(solutions.at(0).revolutions, 0);
+    EXPECT_LT(arma::norm(solutions.at(0).departure_velocity - v1), 1e-6);
+    EXPECT_LT(arma::norm(solutions.at(0).arrival_velocity - arrival.subvec(3, 5)), 1e-6);
+  }
+}
+
+TEST(TestLambert, MultiRevolutionSolutionsReachTarget)
+{
+  constexpr double tof = 60000.0;
+  const arma::vec3 r2 = kepler_propagate(r1, v1, tof).subvec(0, 2);
+  const auto solutions = solve_lambert(r1, r2, tof, constants::EARTH_MU, true, 3);
+  ASSERT_EQ(solutions.size(), 7u);
+  for (std::size_t i = 0; i < solutions.size(); i++) {
+    EXPECT_EQ(solutions.at(i).revolutions, static_cast<int>((i + 1) / 2));
+    const pv_state_type end = kepler_propagate(r1, solutions.at(i).departure_velocity, tof);
+    EXPECT_LT(arma::norm(end.subvec(0, 2) - r2), 1e-3);
+    EXPECT_LT(arma::norm(end.subvec(3, 5) - solutions.at(i).arrival_velocity), 1e-6);
+  }
+}
+
+TEST(TestLambert, RejectsInvalidProblems)
+{
+  EXPECT_THROW(solve_lambert(r1, 2 * r1, 1000.0), std::runtime_error);
+  EXPECT_THROW(solve_lambert(r1, arma::vec3{0, 7000000.0, 0}, -1.0), std::runtime_error);
+}
+
+TEST(TestLambert, TransferBuildsManeuverPlan)
+{
+  const pv_state_type departure = circular_state(7000000.0, 0.0);
+  const pv_state_type arrival = circular_state(8000000.0, 2.5);
+  const lambert_transfer transfer(departure, arrival, 3000.0);
+  const auto plan = transfer.get_maneuver_plan(100.0);
+
+  EXPECT_NEAR(plan->get_total_delta_v(), transfer.get_total_dv(), 1e-9);
+  const arma::vec3 dv = transfer.get_delta_vs().at(0);
+  const arma::vec3 dv_eci = eci2ric(departure.subvec(0, 2), departure.subvec(3, 5)) * plan->get_maneuvers().at(0).get_delta_v();
+  EXPECT_LT(arma::norm(dv_eci - dv), 1e-9);
+  EXPECT_NEAR(*plan->get_maneuvers().at(1).get_trigger()->get_event_time(), 3100.0, 1e-12);
+}
+
+TEST(TestPorkchop, FindsNearHohmannTransfer)
+{
+  constexpr double initial_radius = 7000000.0;
+  constexpr double target_radius = 42164154.0;
+  const hohmann_transfer hohmann(initial_radius, target_radius);
+  const double transit = hohmann.get_transit_time();
+  const double target_rate = std::sqrt(constants::EARTH_MU / std::pow(target_radius, 3));
+
+  // The target is just past the point opposite departure after a Hohmann transit
+  const ephemeris_function departure = kepler_ephemeris(circular_state(initial_radius, 0.0));
+  const ephemeris_function arrival = kepler_ephemeris(circular_state(target_radius, arma::datum::pi + 0.05 - target_rate * transit));
+  const arma::vec departure_times = arma::regspace(0.0, 300.0, 1200.0);
+  const arma::vec arrival_times = arma::regspace(transit - 1800.0, 600.0, transit + 1800.0);
+  const porkchop_sweep sweep(departure, arrival, departure_times, arrival_times);
+
+  const arma::mat& dv = sweep.get_total_dv();
+  ASSERT_EQ(dv.n_rows, departure_times.n_elem);
+  ASSERT_EQ(dv.n_cols, arrival_times.n_elem);
+  EXPECT_GT(dv.min(), hohmann.get_total_dv());
+  EXPECT_LT(dv.min(), hohmann.get_total_dv() + 50.0);
+
+  const auto [row, col] = sweep.get_best_index();
+  EXPECT_EQ(row, 0u);
+  const lambert_transfer best = sweep.get_best_transfer();
+  EXPECT_NEAR(best.get_total_dv(), dv(row, col), 1e-9);
+  EXPECT_NEAR(best.get_transit_time(), arrival_times(col), 1e-9);
+}
+
+TEST(TestPorkchop, BestTransferStartsAtItsDepartureTime)
+{
+  constexpr double initial_radius = 7000000.0;
+  constexpr double target_radius = 42164154.0;
+  const hohmann_transfer hohmann(initial_radius, target_radius);
+  const double transit = hohmann.get_transit_time();
+  const double initial_rate = std::sqrt(constants::EARTH_MU / std::pow(initial_radius, 3));
+  const double target_rate = std::sqrt(constants::EARTH_MU / std::pow(target_radius, 3));
+
+  // Same geometry as above with the departure delayed by 600 s
+  constexpr double delay = 600.0;
+  const ephemeris_function departure = kepler_ephemeris(circular_state(initial_radius, 0.0));
+  const ephemeris_function arrival = kepler_ephemeris(circular_state(
+      target_radius, arma::datum::pi + 0.05 + initial_rate * delay - target_rate * (transit + delay)));
+  const arma::vec departure_times = arma::regspace(0.0, 300.0, 1200.0);
+  const arma::vec arrival_times = arma::regspace(transit + delay - 1800.0, 600.0, transit + delay + 1800.0);
+  const porkchop_sweep sweep(departure, arrival, departure_times, arrival_times);
+
+  const auto [row, col] = sweep.get_best_index();
+  EXPECT_EQ(row, 2u);
+  const lambert_transfer best = sweep.get_best_transfer();
+  EXPECT_DOUBLE_EQ(best.get_departure_time(), departure_times(row));
+  const auto plan = best.get_maneuver_plan();
+  EXPECT_NEAR(*plan->get_maneuvers().at(0).get_trigger()->get_event_time(), departure_times(row), 1e-12);
+  EXPECT_NEAR(*plan->get_maneuvers().at(1).get_trigger()->get_event_time(), arrival_times(col), 1e-9);
+}
+
+TEST(TestPorkchop, ArrivalBeforeDepartureIsInfinite)
+{
+  const ephemeris_function departure = kepler_ephemeris(circular_state(7000000.0, 0.0));
+  const ephemeris_function arrival = kepler_ephemeris(circular_state(8000000.0, 1.0));
+  const porkchop_sweep sweep(departure, arrival, {1000.0, 2000.0}, {1500.0});
+  EXPECT_TRUE(std::isfinite(sweep.get_total_dv()(0, 0)));
+  EXPECT_TRUE(std::isinf(sweep.get_total_dv()(1, 0)));
+}
@@ -1,3 +1,284 @@
 //
 // Created by alex on 7/6/2024.
 //
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "observers/async_csv_writer_observer.h"
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "observers/binary_trajectory_writer_observer.h"
+#include "observers/chebyshev_ephemeris_observer.h"
+#include "observers/ring_buffer_observer.h"
+#include "observers/spsc_ring_buffer.h"
+#include "orbits/chebyshev_ephemeris.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "simulation/simulation.h"
+#include "spacecraft/spacecraft.h"
+#include "systems/system.h"
+
+using namespace naomi;
+using namespace naomi::observers;
+
+namespace
+{
+/**
+ * Stand-in for a physical system holding a single spacecraft at a settable
+ * time.
+ */
+struct single_spacecraft_system
+{
+  double t = 0;
+  std::map<std::string, std::shared_ptr<spacecraft>> spacecrafts = {
+    {"sc", std::make_shared<spacecraft>("sc", orbits::get_circular_orbit({7000000.0, 0.0, 0.0}), 100.0)}
+  };
+
+  [[nodiscard]] double get_current_time() const
+  {
+    return t;
+  }
+
+  [[nodiscard]] auto get_spacecrafts() const -> std::map<std::string, std::shared_ptr<spacecraft>>
+  {
+    return spacecrafts;
+  }
+};
+}
+
+TEST(TestSpscRingBuffer, RejectsWhenFull)
+{
+  spsc_ring_buffer<int> queue(4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+
+  int value = -1;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+  EXPECT_THROW(spsc_ring_buffer<int>(3), std::runtime_error);
+}
+
+TEST(TestSpscRingBuffer, TransfersInOrderAcrossThreads)
+{
+  constexpr int n = 100000;
+  spsc_ring_buffer<int> queue(64);
+  std::thread producer([&queue]
+  {
+    for (int i = 0; i < n; i++) {
+      while (! queue.try_push(i)) std::this_thread::yield();
+    }
+  });
+  int expected = 0;
+  int value;
+  while (expected < n) {
+    if (queue.try_pop(value)) {
+      ASSERT_EQ(value, expected++);
+    }
+  }
+  producer.join();
+}
+
+TEST(TestAsyncCsvWriterObserver, WritesEveryRecordWhenBlocking)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_async_csv_writer.csv").string();
+  const auto system = std::make_shared<single_spacecraft_system>();
+  {
+    async_csv_writer_observer<single_spacecraft_system> observer(10.0, path, backpressure_policy::BLOCK, 8, 256);
+    observer.initialize(system);
+    for (int i = 1; i < 100; i++) {
+      system->t = 10.0 * i;
+      observer.observe_state(system);
+    }
+    observer.terminate(system);
+    EXPECT_EQ(observer.get_dropped_count(), 0);
+  }
+
+  std::ifstream fin(path);
+  std::string line;
+  std::getline(fin, line);
+  EXPECT_EQ(line, "t,scid,x,y,z,vx,vy,vz,q0,q1,q2,q3");
+  std::size_t rows = 0;
+  while (std::getline(fin, line)) {
+    EXPECT_EQ(line.rfind(fmt::format("{},sc,7000000,0,0,0,", 10.0 * static_cast<double>(rows)), 0), 0) << line;
+    rows++;
+  }
+  EXPECT_EQ(rows, 100);
+  std::filesystem::remove(path);
+}
+
+TEST(TestBinaryTrajectory, RoundTripsAndQueriesTimeRanges)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_binary_trajectory.bin").string();
+  const auto system = std::make_shared<single_spacecraft_system>();
+  binary_trajectory_writer_observer<single_spacecraft_system> observer(10.0, path, 16);
+  observer.initialize(system);
+  for (int i = 1; i < 100; i++) {
+    system->t = 10.0 * i;
+    observer.observe_state(system);
+  }
+  observer.terminate(system);
+
+  const trajectory_reader reader(path);
+  EXPECT_EQ(reader.get_spacecraft_ids(), std::vector<std::string>({"sc"}));
+  EXPECT_EQ(reader.get_row_count(), 100);
+  EXPECT_EQ(reader.get_chunk_count(), 7);
+
+  const trajectory_chunk first = reader.get_chunk(0);
+  EXPECT_EQ(first.size(), 16);
+  EXPECT_EQ(first.get_scid()[0], 0);
+  EXPECT_DOUBLE_EQ(first.get_column(trajectory_column::X)[0], 7000000.0);
+  EXPECT_DOUBLE_EQ(first.get_column(trajectory_column::Q0)[0], 1.0);
+
+  std::vector<double> times;
+  for (const trajectory_chunk& rows: reader.query(250.0, 505.0)) {
+    const column_view<double> t = rows.get_column(trajectory_column::T);
+    times.insert(times.end(), t.begin(), t.end());
+  }
+  ASSERT_EQ(times.size(), 26);
+  EXPECT_DOUBLE_EQ(times.front(), 250.0);
+  EXPECT_DOUBLE_EQ(times.back(), 500.0);
+  std::filesystem::remove(path);
+}
+
+TEST(TestChebyshevEphemerisObserver, WritesSimulatedTrajectory)
+{
+  typedef physical_system<numeric::numerical_propagator<numeric::rk_dopri5_stepper>> system_type;
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_chebyshev_observer.bin").string();
+  const std::shared_ptr<bodies::celestial_body> earth_body = std::make_shared<bodies::earth>();
+  const spacecraft sc("sc", orbits::get_circular_orbit({7000000.0, 0.0, 0.0}), 100.0);
+  const auto system = std::make_shared<system_type>(sc, std::make_shared<forces::two_body_force_model_eoms>(earth_body));
+  const auto observer = std::make_shared<chebyshev_ephemeris_observer<system_type>>(60.0, path, 1200.0);
+  simulation<system_type> sim(system, {observer});
+  sim.simulate(6000.0);
+
+  const auto read = orbits::read_chebyshev_ephemerides(path);
+  ASSERT_EQ(read.count("sc"), 1);
+  const orbits::chebyshev_ephemeris& loaded = read.at("sc");
+  const orbits::chebyshev_ephemeris& fitted = observer->get_ephemerides().at("sc");
+  ASSERT_EQ(loaded.get_segments().size(), fitted.get_segments().size());
+  EXPECT_DOUBLE_EQ(loaded.get_start_time(), 0.0);
+  EXPECT_DOUBLE_EQ(loaded.get_end_time(), 6000.0);
+  for (const double t : {0.0, 1234.5, 6000.0}) {
+    EXPECT_TRUE(arma::approx_equal(loaded.get_state(t), fitted.get_state(t), "absdiff", 0.0));
+  }
+  const pv_state_type final_state = system->get_spacecraft("sc")->get_pv_coordinates().to_vec().subvec(0, 5);
+  EXPECT_LT(arma::norm(loaded.get_state(6000.0).subvec(0, 2) - final_state.subvec(0, 2)), 1e-2);
+  std::filesystem::remove(path);
+}
+
+TEST(TestChebyshevEphemerisObserver, RejectsTooSparseSamples)
+{
+  typedef physical_system<numeric::numerical_propagator<numeric::rk_dopri5_stepper>> system_type;
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_chebyshev_sparse.bin").string();
+  const std::shared_ptr<bodies::celestial_body> earth_body = std::make_shared<bodies::earth>();
+  const spacecraft sc("sc", orbits::get_circular_orbit({7000000.0, 0.0, 0.0}), 100.0);
+  const auto system = std::make_shared<system_type>(sc, std::make_shared<forces::two_body_force_model_eoms>(earth_body));
+  // Three samples per segment, the one in the middle can't be met by a fit of the other two
+  const auto observer = std::make_shared<chebyshev_ephemeris_observer<system_type>>(600.0, path, 1200.0);
+  simulation<system_type> sim(system, {observer});
+  EXPECT_THROW(sim.simulate(1200.0), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(TestStateHistory, SnapshotsWrapAroundTheRing)
+{
+  state_history history(4);
+  const vector_type pv(9, arma::fill::zeros);
+  const quaternion_type attitude = {1, 0, 0, 0};
+  for (int i = 0; i < 10; i++) {
+    history.push(i, pv, attitude);
+  }
+  EXPECT_EQ(history.get_sequence(), 10);
+
+  const history_snapshot snap = history.snapshot();
+  EXPECT_EQ(snap.first_sequence, 6);
+  EXPECT_EQ(snap.size(), 4);
+  const auto& [older, newer] = snap.get_column(trajectory_column::T);
+  EXPECT_EQ(older.size(), 2);
+  EXPECT_EQ(newer.size(), 2);
+  for (std::size_t i = 0; i < snap.size(); i++) {
+    EXPECT_DOUBLE_EQ(snap.at(trajectory_column::T, i), 6.0 + static_cast<double>(i));
+  }
+  EXPECT_TRUE(history.is_intact(snap));
+
+  // The next push overwrites the oldest sample of the snapshot
+  history.push(10, pv, attitude);
+  EXPECT_EQ(history.get_overwritten_count(snap), 1);
+  EXPECT_EQ(history.snapshot(2).first_sequence, 9);
+}
+
+TEST(TestStateHistory, ConcurrentReadersSeeConsistentSamples)
+{
+  // A small ring so that the writer keeps overwriting the snapshots
+  state_history history(16);
+  constexpr std::uint64_t n_samples = 200000;
+  std::atomic<bool> done = false;
+  std::atomic<std::size_t> checked = 0;
+
+  auto reader = [&]()
+  {
+    // At least one pass, even if the writer is already done
+    do {
+      const history_snapshot snap = history.snapshot();
+      std::vector<std::array<double, history_column_count>> samples(snap.size());
+      for (std::size_t i = 0; i < snap.size(); i++) {
+        for (std::size_t c = 0; c < history_column_count; c++) {
+          samples[i][c] = snap.at(static_cast<trajectory_column>(c), i);
+        }
+      }
+      // Every column of a sample holds its sequence number
+      for (std::size_t i = history.get_overwritten_count(snap); i < samples.size(); i++) {
+        for (std::size_t c = 0; c < history_column_count; c++) {
+          ASSERT_EQ(samples[i][c], static_cast<double>(snap.first_sequence + i));
+        }
+        checked++;
+      }
+    } while (! done.load());
+  };
+  std::thread first(reader);
+  std::thread second(reader);
+
+  vector_type pv(9);
+  quaternion_type attitude;
+  for (std::uint64_t sequence = 0; sequence < n_samples; sequence++) {
+    const auto value = static_cast<double>(sequence);
+    pv.fill(value);
+    attitude.fill(value);
+    history.push(value, pv, attitude);
+  }
+  done = true;
+  first.join();
+  second.join();
+
+  EXPECT_EQ(history.get_sequence(), n_samples);
+  EXPECT_GT(checked.load(), 0);
+}
+
+TEST(TestRingBufferObserver, KeepsRecentStatesPerSpacecraft)
+{
+  const auto system = std::make_shared<single_spacecraft_system>();
+  ring_buffer_observer<single_spacecraft_system> observer(10.0, 8);
+  observer.initialize(system);
+  for (int i = 1; i < 20; i++) {
+    system->t = 10.0 * i;
+    observer.observe_state(system);
+  }
+
+  const auto history = observer.get_history("sc");
+  const history_snapshot snap = history->snapshot();
+  ASSERT_EQ(snap.size(), 8);
+  EXPECT_DOUBLE_EQ(snap.at(trajectory_column::T, 7), 190.0);
+  EXPECT_DOUBLE_EQ(snap.at(trajectory_column::X, 7), 7000000.0);
+  EXPECT_THROW(observer.get_history("other"), std::runtime_error);
+}
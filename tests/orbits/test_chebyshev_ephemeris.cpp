@@ -0,0 +1,101 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "orbits/chebyshev_ephemeris.h"
+#include "orbits/orbits.h"
+
+using namespace naomi;
+using namespace naomi::orbits;
+
+namespace
+{
+pv_state_type get_state(const double t)
+{
+  vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) *= 1.1;
+  return kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), t);
+}
+}
+
+TEST(TestChebyshevEphemeris, FitsWithinTolerance)
+{
+  const chebyshev_ephemeris ephemeris = chebyshev_ephemeris::from_function(get_state, 0.0, 20000.0, 1200.0, 1e-3);
+  EXPECT_DOUBLE_EQ(ephemeris.get_start_time(), 0.0);
+  EXPECT_DOUBLE_EQ(ephemeris.get_end_time(), 20000.0);
+
+  for (double t = 0.0; t <= 20000.0; t += 7.3) {
+    const pv_state_type expected = get_state(t);
+    const pv_state_type actual = ephemeris.get_state(t);
+    EXPECT_LT(arma::norm(actual.subvec(0, 2) - expected.subvec(0, 2)), 1e-2) << t;
+    EXPECT_LT(arma::norm(actual.subvec(3, 5) - expected.subvec(3, 5)), 1e-3) << t;
+  }
+  // At least 5x fewer numbers than a state every 10 s
+  EXPECT_LT(ephemeris.get_coefficient_count() * 5, 6 * 2000);
+  EXPECT_THROW(ephemeris.get_state(20001.0), std::runtime_error);
+}
+
+TEST(TestChebyshevEphemeris, ChecksFitBetweenSamples)
+{
+  // A 1 m bump that vanishes with its derivative every 80 s, on the samples
+  // a 1200 s segment of degree 15 is fitted to
+  auto bumped_state = [](const double t)
+  {
+    pv_state_type pv = get_state(t);
+    const double phase = arma::datum::pi * t / 80.0;
+    pv(0) += std::pow(std::sin(phase), 2);
+    pv(3) += 2 * std::sin(phase) * std::cos(phase) * arma::datum::pi / 80.0;
+    return pv;
+  };
+  const chebyshev_ephemeris ephemeris = chebyshev_ephemeris::from_function(bumped_state, 0.0, 1200.0, 1200.0, 1e-3);
+  EXPECT_GT(ephemeris.get_segments().size(), 1);
+  for (double t = 0.0; t <= 1200.0; t += 3.7) {
+    EXPECT_LT(arma::norm(ephemeris.get_state(t).subvec(0, 2) - bumped_state(t).subvec(0, 2)), 1e-2) << t;
+  }
+}
+
+TEST(TestChebyshevEphemeris, RejectsFitItCannotCheck)
+{
+  const std::vector<double> times = {0.0, 600.0};
+  const std::vector<pv_state_type> states = {get_state(0.0), get_state(600.0)};
+  EXPECT_FALSE(fit_chebyshev_segment(times, states, 0.0, 600.0, 1e-3).has_value());
+
+  chebyshev_ephemeris ephemeris;
+  EXPECT_THROW(ephemeris.fit(times, states, 0.0, 600.0, 1e-3), std::runtime_error);
+}
+
+TEST(TestChebyshevEphemeris, RoundTripsThroughFile)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_chebyshev.bin").string();
+  const chebyshev_ephemeris ephemeris = chebyshev_ephemeris::from_function(get_state, 0.0, 5000.0, 1000.0, 1e-3);
+  write_chebyshev_ephemerides(path, {{"sc", ephemeris}});
+
+  const auto read = read_chebyshev_ephemerides(path);
+  ASSERT_EQ(read.count("sc"), 1);
+  const chebyshev_ephemeris& loaded = read.at("sc");
+  ASSERT_EQ(loaded.get_segments().size(), ephemeris.get_segments().size());
+  for (const double t : {0.0, 1234.5, 5000.0}) {
+    EXPECT_TRUE(arma::approx_equal(loaded.get_state(t), ephemeris.get_state(t), "absdiff", 0.0));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(TestChebyshevEphemeris, RejectsTruncatedName)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_chebyshev_truncated.bin").string();
+  const chebyshev_ephemeris ephemeris = chebyshev_ephemeris::from_function(get_state, 0.0, 1000.0, 1000.0, 1e-3);
+  write_chebyshev_ephemerides(path, {{"spacecraft", ephemeris}});
+  // Cut the file in the middle of the name, after magic, version, count and
+  // name length
+  std::filesystem::resize_file(path, 8 + 4 + 4 + 4 + 3);
+  EXPECT_THROW(read_chebyshev_ephemerides(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,73 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "constants.h"
+#include "orbits/equinoctial.h"
+#include "orbits/keplerian.h"
+
+using namespace naomi;
+using namespace naomi::orbits;
+
+namespace
+{
+void expect_round_trip(const arma::vec3& r, const arma::vec3& v)
+{
+  const pv_state_type pv = equinoctial_orbit::from_cartesian(r, v).to_cartesian();
+  EXPECT_LT(arma::norm(pv.subvec(0, 2) - r), 1e-6);
+  EXPECT_LT(arma::norm(pv.subvec(3, 5) - v), 1e-9);
+}
+}
+
+TEST(TestEquinoctial, CircularEquatorialRoundTrip)
+{
+  const double speed = std::sqrt(constants::EARTH_MU / 7000000.0);
+  const equinoctial_orbit elements = equinoctial_orbit::from_cartesian({0, 7000000.0, 0}, {-speed, 0, 0});
+  EXPECT_NEAR(elements.get_p(), 7000000.0, 1e-6);
+  EXPECT_NEAR(elements.get_f(), 0.0, 1e-12);
+  EXPECT_NEAR(elements.get_g(), 0.0, 1e-12);
+  EXPECT_NEAR(elements.get_h(), 0.0, 1e-12);
+  EXPECT_NEAR(elements.get_k(), 0.0, 1e-12);
+  EXPECT_NEAR(elements.get_true_longitude(), arma::datum::pi / 2, 1e-12);
+  expect_round_trip({0, 7000000.0, 0}, {-speed, 0, 0});
+}
+
+TEST(TestEquinoctial, GeneralOrbitRoundTrip)
+{
+  expect_round_trip({6800000.0, -1200000.0, 2500000.0}, {1500.0, 6900.0, 2100.0});
+  expect_round_trip({-4000000.0, 5000000.0, -3000000.0}, {-5500.0, -3000.0, 4200.0});
+}
+
+TEST(TestEquinoctial, KeplerianRoundTrip)
+{
+  const keplerian_orbit kep(12000000.0, 0.3, 0.9, 1.2, 2.1, 0.7, AnomalyType::TRUE);
+  const equinoctial_orbit elements = equinoctial_orbit::from_keplerian(kep);
+  EXPECT_LT(arma::norm(elements.to_cartesian() - kep.to_cartesian()), 1e-6);
+
+  const keplerian_orbit back = elements.to_keplerian();
+  EXPECT_NEAR(back.get_a(), 12000000.0, 1e-6);
+  EXPECT_NEAR(back.get_e(), 0.3, 1e-12);
+  EXPECT_NEAR(back.get_i(false), 0.9, 1e-12);
+  EXPECT_NEAR(back.get_raan(false), 1.2, 1e-12);
+  EXPECT_NEAR(back.get_aop(false), 2.1, 1e-12);
+  EXPECT_NEAR(back.get_true_anomaly(), 0.7, 1e-12);
+}
+
+TEST(TestEquinoctial, UnperturbedRatesOnlyMoveTrueLongitude)
+{
+  const equinoctial_orbit elements = equinoctial_orbit::from_cartesian(
+      {6800000.0, -1200000.0, 2500000.0}, {1500.0, 6900.0, 2100.0});
+  const pv_state_type rates = elements.get_derivative({0, 0, 0});
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(rates(i), 0.0);
+  }
+  // dL/dt is the angular rate h / r^2
+  const pv_state_type pv = elements.to_cartesian();
+  const double r = arma::norm(pv.subvec(0, 2));
+  const double h = arma::norm(arma::cross(arma::vec3(pv.subvec(0, 2)), arma::vec3(pv.subvec(3, 5))));
+  EXPECT_NEAR(rates(5), h / (r * r), 1e-15);
+}
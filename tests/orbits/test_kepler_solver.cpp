@@ -0,0 +1,63 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <cmath>
+#include <limits>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include <boost/math/tools/roots.hpp>
+
+#include "orbits/kepler_solver.h"
+#include "orbits/keplerian.h"
+
+using namespace naomi::orbits;
+
+TEST(TestKeplerSolver, EllipticMatchesNewtonRaphson)
+{
+  for (const double e: {0.0, 0.01, 0.3, 0.7, 0.95, 0.999}) {
+    for (double m = -3.1; m < 3.1; m += 0.05) {
+      const double expected = boost::math::tools::newton_raphson_iterate(
+          eccentric_anomaly_functor<double>(e, m), m, -4.0, 4.0, std::numeric_limits<double>::digits);
+      EXPECT_NEAR(solve_kepler_elliptic(e, m), expected, 1e-14) << "e = " << e << ", M = " << m;
+    }
+  }
+}
+
+TEST(TestKeplerSolver, EllipticKeepsTheRevolution)
+{
+  const double e = 0.4;
+  const double m = 0.8;
+  const double two_pi = 2 * arma::datum::pi;
+  EXPECT_NEAR(solve_kepler_elliptic(e, m + 3 * two_pi), solve_kepler_elliptic(e, m) + 3 * two_pi, 1e-12);
+  EXPECT_NEAR(solve_kepler_elliptic(e, m - 2 * two_pi), solve_kepler_elliptic(e, m) - 2 * two_pi, 1e-12);
+}
+
+TEST(TestKeplerSolver, HyperbolicResidual)
+{
+  for (const double e: {1.001, 1.1, 2.0, 10.0}) {
+    for (const double m: {0.0, 1e-3, 0.5, 3.0, 50.0, 1e4}) {
+      for (const double sign: {-1.0, 1.0}) {
+        const double h = solve_kepler_hyperbolic(e, sign * m);
+        const double error = (e * std::sinh(h) - h - sign * m) / (e * std::cosh(h) - 1);
+        EXPECT_LE(std::abs(error), 1e-14 * std::max(1.0, std::abs(h))) << "e = " << e << ", M = " << sign * m;
+      }
+    }
+  }
+}
+
+TEST(TestKeplerSolver, BatchMatchesScalar)
+{
+  const arma::vec e = arma::linspace(0.0, 0.99, 1000);
+  const arma::vec m = arma::linspace(-10.0, 10.0, 1000);
+  const arma::vec eccentric_anomaly = solve_kepler_elliptic(e, m);
+  const arma::vec hyperbolic_anomaly = solve_kepler_hyperbolic(e + 1.01, m);
+  for (std::size_t i = 0; i < e.n_elem; i++) {
+    EXPECT_DOUBLE_EQ(eccentric_anomaly(i), solve_kepler_elliptic(e(i), m(i)));
+    EXPECT_DOUBLE_EQ(hyperbolic_anomaly(i), solve_kepler_hyperbolic(e(i) + 1.01, m(i)));
+  }
+  EXPECT_THROW(solve_kepler_elliptic(e, arma::vec(3)), std::runtime_error);
+}
@@ -0,0 +1,121 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "orbits/keplerian.h"
+#include "orbits/orbit_batch.h"
+
+using namespace naomi::orbits;
+
+namespace
+{
+void expect_same_state(const cartesian_batch& a, const cartesian_batch& b, const std::size_t i)
+{
+  EXPECT_NEAR(a.x[i], b.x[i], 1e-6);
+  EXPECT_NEAR(a.y[i], b.y[i], 1e-6);
+  EXPECT_NEAR(a.z[i], b.z[i], 1e-6);
+  EXPECT_NEAR(a.vx[i], b.vx[i], 1e-9);
+  EXPECT_NEAR(a.vy[i], b.vy[i], 1e-9);
+  EXPECT_NEAR(a.vz[i], b.vz[i], 1e-9);
+}
+
+keplerian_batch random_elements(const std::size_t n, const bool hyperbolic)
+{
+  arma::arma_rng::set_seed(7);
+  keplerian_batch elements(n);
+  for (std::size_t i = 0; i < n; i++) {
+    const arma::vec u = arma::randu(6);
+    elements.sma[i] = hyperbolic ? -1e7 * (0.5 + u(0)) : 7e6 + 3e7 * u(0);
+    elements.ecc[i] = hyperbolic ? 1.05 + 2 * u(1) : 0.01 + 0.9 * u(1);
+    elements.inc[i] = 0.01 + 3.1 * u(2);
+    elements.raan[i] = 2 * arma::datum::pi * u(3);
+    elements.aop[i] = 2 * arma::datum::pi * u(4);
+    elements.ma[i] = hyperbolic ? -5 + 10 * u(5) : 2 * arma::datum::pi * u(5);
+  }
+  return elements;
+}
+}
+
+TEST(TestOrbitBatch, EllipticRoundTrip)
+{
+  const keplerian_batch elements = random_elements(500, false);
+  const keplerian_batch back = cartesian_to_keplerian(keplerian_to_cartesian(elements));
+  for (std::size_t i = 0; i < elements.size(); i++) {
+    EXPECT_NEAR(back.sma[i] / elements.sma[i], 1.0, 1e-10);
+    EXPECT_NEAR(back.ecc[i], elements.ecc[i], 1e-10);
+    EXPECT_NEAR(back.inc[i], elements.inc[i], 1e-10);
+    EXPECT_NEAR(back.raan[i], elements.raan[i], 1e-9);
+    EXPECT_NEAR(back.aop[i], elements.aop[i], 1e-8);
+    EXPECT_NEAR(std::remainder(back.ma[i] - elements.ma[i], 2 * arma::datum::pi), 0.0, 1e-8);
+  }
+}
+
+TEST(TestOrbitBatch, HyperbolicRoundTrip)
+{
+  const keplerian_batch elements = random_elements(200, true);
+  const keplerian_batch back = cartesian_to_keplerian(keplerian_to_cartesian(elements));
+  for (std::size_t i = 0; i < elements.size(); i++) {
+    EXPECT_NEAR(back.sma[i] / elements.sma[i], 1.0, 1e-10);
+    EXPECT_NEAR(back.ecc[i], elements.ecc[i], 1e-10);
+    EXPECT_NEAR(back.ma[i], elements.ma[i], 1e-8);
+  }
+}
+
+TEST(TestOrbitBatch, SingularOrbitsFollowTheConvention)
+{
+  // circular inclined, elliptic equatorial, circular equatorial, circular retrograde equatorial
+  keplerian_batch elements(4);
+  elements.sma = {7e6, 8e6, 7e6, 7e6};
+  elements.ecc = {0.0, 0.1, 0.0, 0.0};
+  elements.inc = {0.5, 0.0, 0.0, arma::datum::pi};
+  elements.raan = {1.0, 0.0, 0.0, 0.0};
+  elements.aop = {0.0, 2.0, 0.0, 0.0};
+  elements.ma = {0.7, 0.3, 2.5, 2.5};
+
+  const cartesian_batch states = keplerian_to_cartesian(elements);
+  const keplerian_batch back = cartesian_to_keplerian(states);
+  for (std::size_t i = 0; i < elements.size(); i++) {
+    EXPECT_NEAR(back.ecc[i], elements.ecc[i], 1e-10) << i;
+    EXPECT_NEAR(back.inc[i], elements.inc[i], 1e-10) << i;
+    EXPECT_NEAR(back.raan[i], elements.raan[i], 1e-10) << i;
+    EXPECT_NEAR(back.aop[i], elements.aop[i], 1e-9) << i;
+    EXPECT_NEAR(back.ma[i], elements.ma[i], 1e-9) << i;
+  }
+  expect_same_state(keplerian_to_cartesian(back), states, 0);
+}
+
+TEST(TestOrbitBatch, ParallelBatchMatchesScalarKernel)
+{
+  const std::size_t n = parallel_batch_threshold + 123;
+  const keplerian_batch elements = random_elements(n, false);
+  const cartesian_batch states = keplerian_to_cartesian(elements);
+  for (std::size_t i = 0; i < n; i += 997) {
+    const arma::vec6 pv = keplerian_to_cartesian(elements.sma[i], elements.ecc[i], elements.inc[i],
+                                                 elements.raan[i], elements.aop[i], elements.ma[i]);
+    EXPECT_DOUBLE_EQ(states.x[i], pv(0));
+    EXPECT_DOUBLE_EQ(states.vz[i], pv(5));
+  }
+  EXPECT_EQ(cartesian_to_keplerian(states).size(), n);
+}
+
+TEST(TestOrbitBatch, MatchesKeplerianOrbit)
+{
+  const keplerian_orbit orbit(7000000.0, 0.01, 0.9, 0.3, 0.2, 1.0);
+  const arma::vec6 expected = orbit.to_cartesian();
+  const arma::vec6 pv = keplerian_to_cartesian(7000000.0, 0.01, 0.9, 0.3, 0.2, 1.0);
+  for (arma::uword i = 0; i < 3; i++) {
+    EXPECT_NEAR(pv(i), expected(i), 1e-6);
+    EXPECT_NEAR(pv(i + 3), expected(i + 3), 1e-9);
+  }
+}
+
+TEST(TestOrbitBatch, RejectsRaggedBatches)
+{
+  cartesian_batch states(3);
+  states.vz.resize(2);
+  EXPECT_THROW(cartesian_to_keplerian(states), std::runtime_error);
+}
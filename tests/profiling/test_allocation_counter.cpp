@@ -0,0 +1,63 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "orbits/orbits.h"
+#include "profiling/allocation_counter.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::profiling;
+
+TEST(TestAllocationCounter, CountsAllocationsOfTheScope)
+{
+  if (! allocation_counting_enabled) {
+    GTEST_SKIP() << "Built without NAOMI_COUNT_ALLOCATIONS";
+  }
+  allocation_scope scope;
+  {
+    const auto value = std::make_unique<double>(1.0);
+    std::vector<double> values;
+    values.reserve(100);
+  }
+  const allocation_counts counts = scope.get();
+  EXPECT_EQ(counts.allocations, 2);
+  EXPECT_EQ(counts.deallocations, 2);
+  EXPECT_GE(counts.bytes, sizeof(double) * 101);
+
+  // Other threads have their own counters
+  scope.reset();
+  std::thread([] { const std::vector<double> values(1000); }).join();
+  EXPECT_LT(scope.get().bytes, 1000 * sizeof(double));
+}
+
+TEST(TestAllocationCounter, TwoBodyDerivativeAllocationBound)
+{
+  if (! allocation_counting_enabled) {
+    GTEST_SKIP() << "Built without NAOMI_COUNT_ALLOCATIONS";
+  }
+  const two_body_force_model_eoms eoms(std::make_shared<earth>());
+  vector_type x(9, arma::fill::zeros);
+  x.subvec(0, 5) = orbits::get_circular_orbit({3900000.0, 3900000.0, 3900000.0});
+  static_cast<void>(eoms.get_derivative(x, 0.0));
+
+  constexpr std::size_t calls = 100;
+  const allocation_scope scope;
+  for (std::size_t i = 0; i < calls; i++) {
+    static_cast<void>(eoms.get_derivative(x, 0.0));
+  }
+  // Mostly the argument vectors of the three potential partial visitors,
+  // lower the bound when the RHS gets cheaper
+  EXPECT_LE(scope.get().allocations, 8 * calls);
+}
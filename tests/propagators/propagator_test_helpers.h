@@ -0,0 +1,128 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#ifndef PROPAGATOR_TEST_HELPERS_H
+#define PROPAGATOR_TEST_HELPERS_H
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+
+#include "constants.h"
+#include "forces/force_model.h"
+#include "orbits/orbits.h"
+#include "propagators/event_detector.h"
+#include "propagators/event_handler.h"
+#include "spacecraft/spacecraft.h"
+
+namespace naomi::test_helpers
+{
+/**
+ * Point mass gravity of the earth, the derivative of every component after
+ * [r, v] is zero.
+ */
+class point_mass_eoms final : public forces::equations_of_motion
+{
+public:
+  [[nodiscard]] vector_type get_derivative(const vector_type& state, double) const override
+  {
+    const arma::vec3 pos = state.subvec(0, 2);
+    const double r = norm(pos);
+    vector_type dxdt(state.n_elem, arma::fill::zeros);
+    dxdt(arma::span(0, 2)) = state.subvec(3, 5);
+    dxdt(arma::span(3, 5)) = -constants::EARTH_MU / (r * r * r) * pos;
+    return dxdt;
+  }
+};
+
+/**
+ * Records the times of every apoapsis and periapsis.
+ */
+class recording_apside_detector final : public events::event_detector
+{
+public:
+  std::vector<double> times;
+
+  explicit recording_apside_detector(const double max_check_interval)
+      : event_detector(events::ALL, max_check_interval)
+  {
+  }
+
+  [[nodiscard]] double g(const events::state_and_time_type& sv) const override
+  {
+    return dot(sv.first.subvec(0, 2), sv.first.subvec(3, 5));
+  }
+
+  void handle_event(const std::shared_ptr<spacecraft>&, const double t) override
+  {
+    times.push_back(t);
+  }
+};
+
+/**
+ * Appends the time of every sign change of `g` to a log that may be shared
+ * with other detectors, to check the order in which events are handled.
+ */
+class logging_detector final : public events::event_detector
+{
+  std::function<double(const events::state_and_time_type&)> m_g;
+  std::shared_ptr<std::vector<double>> m_log;
+
+public:
+  logging_detector(std::function<double(const events::state_and_time_type&)> g,
+                   std::shared_ptr<std::vector<double>> log,
+                   const double max_check_interval)
+      : event_detector(events::ALL, max_check_interval), m_g(std::move(g)), m_log(std::move(log))
+  {
+  }
+
+  [[nodiscard]] double g(const events::state_and_time_type& sv) const override
+  {
+    return m_g(sv);
+  }
+
+  void handle_event(const std::shared_ptr<spacecraft>&, const double t) override
+  {
+    m_log->push_back(t);
+  }
+};
+
+/**
+ * Records the spacecraft and the time of every event it handles.
+ */
+class recording_handler final : public events::event_handler
+{
+public:
+  std::vector<std::pair<std::string, double>> events;
+
+  void handle_event(const std::shared_ptr<spacecraft>& sc, const double t) override
+  {
+    events.emplace_back(sc->get_identifier(), t);
+  }
+};
+
+/**
+ * Eccentric orbit starting shortly after periapsis, returns the state and the
+ * times of the first apoapsis and periapsis
+ */
+inline std::tuple<vector_type, double, double> get_eccentric_orbit()
+{
+  vector_type state = orbits::get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) *= 1.2;
+  const double v = arma::norm(state.subvec(3, 5));
+  const double a = 1 / (2 / 7000000.0 - v * v / constants::EARTH_MU);
+  const double period = 2 * arma::datum::pi * std::sqrt(a * a * a / constants::EARTH_MU);
+  const double offset = 100.0;
+  state.subvec(0, 5) = orbits::kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), offset);
+  return {state, period / 2 - offset, period - offset};
+}
+}
+
+#endif //PROPAGATOR_TEST_HELPERS_H
@@ -0,0 +1,31 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "orbits/orbits.h"
+#include "propagators/encke_propagator.h"
+#include "propagators/numerical_propagator.h"
+
+#include "propagator_test_helpers.h"
+
+using namespace naomi;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+using namespace naomi::test_helpers;
+
+TEST(TestEnckePropagator, UnperturbedOrbitStaysOnReference)
+{
+  const vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+
+  encke_propagator<rk_dopri5_stepper> propagator(rk_dopri5_stepper(), 1e-9, 1e-9);
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.propagate_to(20000.0);
+
+  // The deviation stays zero, the initial reference is never rectified
+  EXPECT_EQ(propagator.get_rectification_count(), 1);
+}
@@ -0,0 +1,87 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <utility>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/equinoctial_propagator.h"
+#include "propagators/numerical_propagator.h"
+
+#include "propagator_test_helpers.h"
+
+using namespace naomi;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+using namespace naomi::test_helpers;
+
+namespace
+{
+/**
+ * Point mass gravity plus a small constant acceleration, like solar radiation
+ * pressure, counting the evaluations.
+ */
+class counting_perturbed_eoms final : public equations_of_motion
+{
+  point_mass_eoms m_point_mass;
+  arma::vec3 m_acceleration;
+
+public:
+  mutable std::size_t evaluations = 0;
+
+  explicit counting_perturbed_eoms(const arma::vec3& acceleration)
+      : m_acceleration(acceleration)
+  {
+  }
+
+  [[nodiscard]] vector_type get_derivative(const vector_type& state, const double t) const override
+  {
+    evaluations++;
+    vector_type dxdt = m_point_mass.get_derivative(state, t);
+    dxdt(arma::span(3, 5)) += m_acceleration;
+    return dxdt;
+  }
+};
+
+/**
+ * @return The final position and the number of evaluations of the equations
+ * of motion
+ */
+template <typename Propagator>
+std::pair<arma::vec3, std::size_t> propagate_perturbed(Propagator propagator, const vector_type& state, const double duration)
+{
+  const auto eoms = std::make_shared<counting_perturbed_eoms>(arma::vec3({1e-7, -2e-7, 1e-7}));
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  propagator.initialize(eoms, {{"sc", sc}});
+  propagator.propagate_to(duration);
+  return {sc->get_pv_coordinates().get_position(), eoms->evaluations};
+}
+}
+
+TEST(TestEquinoctialPropagator, FewerEvaluationsThanCowellOnLightlyPerturbedOrbit)
+{
+  vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(state.subvec(3, 5));
+  const double duration = 5 * keplerian_orbit::get_orbital_period(7000000.0);
+
+  const auto [reference, reference_evaluations] = propagate_perturbed(
+      numerical_propagator<rk_dopri5_stepper>(integrator<rk_dopri5_stepper>(rk_dopri5_stepper(), 1e-12, 1e-12)),
+      state, duration);
+  const auto [cowell, cowell_evaluations] = propagate_perturbed(
+      numerical_propagator<rk_dopri5_stepper>(integrator<rk_dopri5_stepper>(rk_dopri5_stepper(), 1e-10, 1e-10)),
+      state, duration);
+  const auto [equinoctial, equinoctial_evaluations] = propagate_perturbed(
+      equinoctial_propagator<rk_dopri5_stepper>(rk_dopri5_stepper(), 1e-10, 1e-10), state, duration);
+
+  // Both within a meter of the reference, the elements barely change so their
+  // steps are far longer
+  EXPECT_LT(arma::norm(cowell - reference), 1.0);
+  EXPECT_LT(arma::norm(equinoctial - reference), 1.0);
+  EXPECT_LT(equinoctial_evaluations * 5, cowell_evaluations);
+}
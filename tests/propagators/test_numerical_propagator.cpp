@@ -0,0 +1,211 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "constants.h"
+#include "integrators/symplectic.h"
+#include "orbits/orbits.h"
+#include "propagators/event_detector.h"
+#include "propagators/numerical_propagator.h"
+
+#include "propagator_test_helpers.h"
+
+using namespace naomi;
+using namespace naomi::events;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+using namespace naomi::test_helpers;
+
+namespace
+{
+class recording_time_detector final : public event_detector
+{
+  std::vector<double> m_schedule;
+
+public:
+  std::vector<double> times;
+
+  explicit recording_time_detector(const std::vector<double>& schedule)
+      : event_detector(DECREASING), m_schedule(schedule)
+  {
+  }
+
+  [[nodiscard]] double g(const state_and_time_type& sv) const override
+  {
+    if (times.size() >= m_schedule.size()) return -1.0;
+    return m_schedule.at(times.size()) - sv.second;
+  }
+
+  [[nodiscard]] std::optional<double> get_event_time() const override
+  {
+    if (times.size() >= m_schedule.size()) return std::nullopt;
+    return m_schedule.at(times.size());
+  }
+
+  void handle_event(const std::shared_ptr<spacecraft>&, const double t) override
+  {
+    times.push_back(t);
+  }
+};
+
+/**
+ * Handles the first apside only, then deactivates.
+ */
+class one_shot_apside_detector final : public event_detector
+{
+public:
+  std::vector<double> times;
+
+  one_shot_apside_detector()
+      : event_detector(ALL, 10.0)
+  {
+  }
+
+  [[nodiscard]] double g(const state_and_time_type& sv) const override
+  {
+    return dot(sv.first.subvec(0, 2), sv.first.subvec(3, 5));
+  }
+
+  void handle_event(const std::shared_ptr<spacecraft>&, const double t) override
+  {
+    times.push_back(t);
+    m_is_active = false;
+  }
+};
+
+template <typename Stepper>
+std::vector<double> propagate_apsides(const double duration)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  const auto detector = std::make_shared<recording_apside_detector>(60.0);
+
+  numerical_propagator<Stepper> propagator;
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.add_event_detector(detector);
+  propagator.propagate_to(duration);
+  return detector->times;
+}
+}
+
+TEST(TestNumericalPropagator, DenseOutputFindsEveryApside)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const double half_period = periapsis - apoapsis;
+  const std::vector<double> times = propagate_apsides<rk_dopri5_stepper>(2 * (periapsis + 100.0));
+
+  ASSERT_EQ(times.size(), 4);
+  EXPECT_NEAR(times[0], apoapsis, 1e-3);
+  EXPECT_NEAR(times[1], periapsis, 1e-3);
+  EXPECT_NEAR(times[2], apoapsis + 2 * half_period, 1e-2);
+  EXPECT_NEAR(times[3], periapsis + 2 * half_period, 1e-2);
+}
+
+TEST(TestNumericalPropagator, ControlledStepperFindsEveryApside)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const std::vector<double> times = propagate_apsides<yoshida4_stepper>(periapsis + 100.0);
+
+  ASSERT_EQ(times.size(), 2);
+  EXPECT_NEAR(times[0], apoapsis, 1e-2);
+  EXPECT_NEAR(times[1], periapsis, 1e-2);
+}
+
+TEST(TestNumericalPropagator, StopsExactlyOnTimeEvents)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  const std::vector<double> schedule = {0.0, 1000.0, 1000.0, 1500.3};
+  const auto detector = std::make_shared<recording_time_detector>(schedule);
+
+  numerical_propagator<rk_dopri5_stepper> propagator;
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.add_event_detector(detector);
+  propagator.propagate_to(1000.0);
+  propagator.propagate_to(2000.0);
+
+  // Every time is handled exactly once, even on the boundary of two calls
+  ASSERT_EQ(detector->times.size(), schedule.size());
+  for (std::size_t i = 0; i < schedule.size(); i++) {
+    EXPECT_DOUBLE_EQ(detector->times[i], schedule[i]);
+  }
+}
+
+TEST(TestNumericalPropagator, HandlesSharedTimeEventForEverySpacecraft)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto first = std::make_shared<spacecraft>("first", state, 100.0);
+  const auto second = std::make_shared<spacecraft>("second", state, 100.0);
+  const auto detector = std::make_shared<time_detector>(1000.0);
+  const auto handler = std::make_shared<recording_handler>();
+  detector->add_handler(handler);
+
+  numerical_propagator<rk_dopri5_stepper> propagator;
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"first", first}, {"second", second}});
+  propagator.add_event_detector(detector);
+  propagator.propagate_to(1000.0);
+  propagator.propagate_to(2000.0);
+
+  // Once per spacecraft, also on the boundary of two calls
+  const std::vector<std::pair<std::string, double>> expected = {{"first", 1000.0}, {"second", 1000.0}};
+  EXPECT_EQ(handler->events, expected);
+}
+
+TEST(TestNumericalPropagator, CollectsStatistics)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+
+  numerical_propagator<yoshida4_stepper> propagator;
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.add_event_detector(std::make_shared<recording_apside_detector>(60.0));
+  propagator.propagate_to(periapsis + 100.0);
+
+  const propagation_stats stats = propagator.get_stats();
+  if (NAOMI_ENABLE_STATS) {
+    EXPECT_GT(stats.accepted_steps, 0);
+    EXPECT_GE(stats.rhs_evaluations, stats.accepted_steps);
+    EXPECT_LE(stats.min_step, stats.max_step);
+    EXPECT_GT(stats.event_checks, 0);
+    EXPECT_GT(stats.root_finding_iterations, 0);
+    EXPECT_EQ(stats.events_located, 2);
+  } else {
+    EXPECT_EQ(stats.rhs_evaluations, 0);
+    EXPECT_EQ(stats.accepted_steps, 0);
+    EXPECT_EQ(stats.events_located, 0);
+  }
+  EXPECT_NE(stats.to_json().find("\"rhs_evaluations\""), std::string::npos);
+
+  propagator.reset_stats();
+  EXPECT_EQ(propagator.get_stats().accepted_steps, 0);
+}
+
+TEST(TestNumericalPropagator, StopsSamplingInactiveDetectors)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  const auto detector = std::make_shared<one_shot_apside_detector>();
+
+  numerical_propagator<rk_dopri5_stepper> propagator;
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.add_event_detector(detector);
+  propagator.propagate_to(apoapsis + 100.0);
+  ASSERT_EQ(detector->times.size(), 1);
+  EXPECT_NEAR(detector->times[0], apoapsis, 1e-3);
+
+  propagator.reset_stats();
+  propagator.propagate_to(periapsis + 100.0);
+  EXPECT_EQ(detector->times.size(), 1);
+  EXPECT_EQ(propagator.get_stats().event_checks, 0);
+  if (NAOMI_ENABLE_STATS) {
+    EXPECT_GT(propagator.get_stats().accepted_steps, 0);
+  }
+}
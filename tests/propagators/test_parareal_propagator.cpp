@@ -0,0 +1,92 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/parareal_propagator.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::events;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+TEST(TestPararealPropagator, MatchesSerialRun)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * 1.05 * arma::norm(state.subvec(3, 5));
+  const double duration = 3 * keplerian_orbit::get_orbital_period(7000000.0);
+  const auto apsides = std::make_shared<apside_detector>(ALL);
+
+  // Serial reference
+  const auto serial_sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  const auto serial_events = std::make_shared<event_recorder>(apsides);
+  numerical_propagator<rk_dopri5_stepper> serial;
+  serial.initialize(eoms, {{"sc", serial_sc}});
+  serial.add_event_detector(serial_events);
+  serial.propagate_to(duration);
+
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  parareal_propagator<rk_dopri5_stepper> parareal(sc, eoms, make_kepler_j2_coarse_solver(earth_body), 1e-3, 4);
+  parareal.add_event_detector(apsides);
+  const auto result = parareal.propagate(0.0, duration);
+
+  EXPECT_LE(result.iterations, 4);
+  EXPECT_GT(result.speedup, 0.0);
+  EXPECT_LT(arma::norm(sc->get_pv_coordinates().get_position() - serial_sc->get_pv_coordinates().get_position()), 1.0);
+  ASSERT_EQ(result.events.size(), serial_events->get_times().size());
+  for (std::size_t i = 0; i < result.events.size(); i++) {
+    EXPECT_NEAR(result.events[i].time_occurred, serial_events->get_times()[i], 1e-3);
+  }
+}
+
+TEST(TestPararealPropagator, RecordsTimeEventsOnce)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  const double duration = 3 * keplerian_orbit::get_orbital_period(7000000.0);
+  // Within the second slice and on the boundary of the second and third slice
+  const auto within = std::make_shared<time_detector>(duration / 3);
+  const auto boundary = std::make_shared<time_detector>(duration / 2);
+
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+  parareal_propagator<rk_dopri5_stepper> parareal(sc, eoms, make_kepler_j2_coarse_solver(earth_body), 1e-3, 4);
+  parareal.add_event_detector(within);
+  parareal.add_event_detector(boundary);
+  const auto result = parareal.propagate(0.0, duration);
+
+  ASSERT_EQ(result.events.size(), 2);
+  EXPECT_EQ(result.events[0].detector, within);
+  EXPECT_DOUBLE_EQ(result.events[0].time_occurred, duration / 3);
+  EXPECT_EQ(result.events[1].detector, boundary);
+  EXPECT_DOUBLE_EQ(result.events[1].time_occurred, duration / 2);
+}
+
+TEST(TestPararealPropagator, KeplerJ2CoarseSolverTracksFineSolution)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  vector_type state(9, arma::fill::zeros);
+  state(arma::span(0, 5)) = get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(state.subvec(3, 5));
+  const double duration = 10 * keplerian_orbit::get_orbital_period(7000000.0);
+
+  const vector_type rk4 = make_rk4_coarse_solver(eoms, 10.0)(state, 0.0, duration);
+  const vector_type kepler = kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), duration);
+  const vector_type kepler_j2 = make_kepler_j2_coarse_solver(earth_body)(state, 0.0, duration);
+
+  // Secular J2 drift accounts for most of the departure from the conic
+  EXPECT_LT(arma::norm(kepler_j2.subvec(0, 2) - rk4.subvec(0, 2)),
+            arma::norm(kepler.subvec(0, 2) - rk4.subvec(0, 2)));
+}
@@ -0,0 +1,143 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "orbits/keplerian.h"
+#include "orbits/orbits.h"
+#include "propagators/encke_propagator.h"
+#include "propagators/equinoctial_propagator.h"
+#include "propagators/numerical_propagator.h"
+#include "propagators/regularized_propagator.h"
+#include "systems/system.h"
+
+#include "propagator_test_helpers.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::events;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+using namespace naomi::test_helpers;
+
+/**
+ * Cases shared by the propagators with the interface of
+ * `numerical_propagator`, which has its own tests.
+ */
+template <typename Propagator>
+class TestPropagators : public testing::Test
+{
+protected:
+  static Propagator make_propagator(const double tolerance)
+  {
+    return Propagator(rk_dopri5_stepper(), tolerance, tolerance);
+  }
+};
+
+typedef testing::Types<encke_propagator<rk_dopri5_stepper>,
+                       equinoctial_propagator<rk_dopri5_stepper>,
+                       regularized_propagator<rk_dopri5_stepper>> propagator_types;
+TYPED_TEST_SUITE(TestPropagators, propagator_types);
+
+/**
+ * Cases of the propagators that integrate the deviation from a Kepler conic,
+ * exact on unperturbed orbits.
+ */
+template <typename Propagator>
+class TestConicPropagators : public TestPropagators<Propagator>
+{
+};
+
+typedef testing::Types<encke_propagator<rk_dopri5_stepper>,
+                       equinoctial_propagator<rk_dopri5_stepper>> conic_propagator_types;
+TYPED_TEST_SUITE(TestConicPropagators, conic_propagator_types);
+
+TYPED_TEST(TestConicPropagators, UnperturbedOrbitMatchesKepler)
+{
+  const vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+
+  TypeParam propagator = this->make_propagator(1e-9);
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.propagate_to(20000.0);
+
+  const pv_state_type expected = kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), 20000.0);
+  EXPECT_LT(arma::norm(sc->get_pv_coordinates().get_position() - expected.subvec(0, 2)), 1e-3);
+}
+
+TYPED_TEST(TestConicPropagators, MatchesCowellWithJ2)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  state(arma::span(3, 5)) = arma::vec3({0, 0.8, 0.6}) * arma::norm(state.subvec(3, 5));
+  const double period = keplerian_orbit::get_orbital_period(7000000.0);
+
+  const spacecraft propagated_sc("sc", state, 100.0);
+  physical_system<TypeParam> propagated_system(propagated_sc, eoms);
+  propagated_system.simulate_to(period);
+
+  const spacecraft cowell_sc("sc", state, 100.0);
+  physical_system<numerical_propagator<rk_dopri5_stepper>> cowell_system(cowell_sc, eoms);
+  cowell_system.simulate_to(period);
+
+  const arma::vec3 propagated_pos = propagated_system.get_spacecraft("sc")->get_pv_coordinates().get_position();
+  const arma::vec3 cowell_pos = cowell_system.get_spacecraft("sc")->get_pv_coordinates().get_position();
+  const arma::vec3 kepler_pos = kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), period).subvec(0, 2);
+  // J2 moves the spacecraft well away from the conic, both methods agree
+  EXPECT_GT(arma::norm(cowell_pos - kepler_pos), 100.0);
+  EXPECT_LT(arma::norm(propagated_pos - cowell_pos), 50.0);
+}
+
+TYPED_TEST(TestPropagators, HandlesEarliestEventOfAllDetectors)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto sc = std::make_shared<spacecraft>("sc", state, 100.0);
+
+  // Check intervals longer than a step so that the node crossing and the
+  // apoapsis after it are found in the same interval
+  const auto log = std::make_shared<std::vector<double>>();
+  TypeParam propagator = this->make_propagator(1e-10);
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"sc", sc}});
+  propagator.add_event_detector(std::make_shared<logging_detector>(
+      [](const state_and_time_type& sv) { return dot(sv.first.subvec(0, 2), sv.first.subvec(3, 5)); }, log, 1e5));
+  propagator.add_event_detector(std::make_shared<logging_detector>(
+      [](const state_and_time_type& sv) { return sv.first(0); }, log, 1e5));
+  EXPECT_DOUBLE_EQ(propagator.propagate_to(periapsis + 100.0), periapsis + 100.0);
+
+  ASSERT_EQ(log->size(), 4);
+  EXPECT_TRUE(std::is_sorted(log->begin(), log->end()));
+  EXPECT_NEAR(log->at(1), apoapsis, 1e-2);
+  EXPECT_NEAR(log->at(3), periapsis, 1e-2);
+}
+
+TYPED_TEST(TestPropagators, HandlesSharedTimeEventForEverySpacecraft)
+{
+  const auto [state, apoapsis, periapsis] = get_eccentric_orbit();
+  const auto first = std::make_shared<spacecraft>("first", state, 100.0);
+  const auto second = std::make_shared<spacecraft>("second", state, 100.0);
+  const auto detector = std::make_shared<time_detector>(1000.0);
+  const auto handler = std::make_shared<recording_handler>();
+  detector->add_handler(handler);
+
+  TypeParam propagator = this->make_propagator(1e-9);
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"first", first}, {"second", second}});
+  propagator.add_event_detector(detector);
+  propagator.propagate_to(1000.0);
+  propagator.propagate_to(2000.0);
+
+  // Once per spacecraft, also on the boundary of two calls
+  const std::vector<std::pair<std::string, double>> expected = {{"first", 1000.0}, {"second", 1000.0}};
+  EXPECT_EQ(handler->events, expected);
+}
@@ -0,0 +1,52 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "constants.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "propagators/regularized_propagator.h"
+#include "systems/system.h"
+
+#include "propagator_test_helpers.h"
+
+using namespace naomi;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+using namespace naomi::test_helpers;
+
+TEST(TestRegularizedPropagator, MatchesKeplerOnEccentricOrbit)
+{
+  // Periapsis at 7000 km, e = 0.7
+  const arma::vec3 r0 = {7000000.0, 0.0, 0.0};
+  const arma::vec3 v0 = {0.0, std::sqrt(constants::EARTH_MU * 1.7 / 7000000.0), 0.0};
+  const auto sc = std::make_shared<spacecraft>("heo", arma::join_cols(r0, v0), 100.0);
+
+  regularized_propagator<rk_dopri5_stepper> propagator(rk_dopri5_stepper(), 1e-10, 1e-10);
+  propagator.initialize(std::make_shared<point_mass_eoms>(), {{"heo", sc}});
+
+  for (const double t : {1000.0, 20000.0, 50000.0}) {
+    EXPECT_DOUBLE_EQ(propagator.propagate_to(t), t);
+    const pv_state_type expected = kepler_propagate(r0, v0, t);
+    const auto pv = sc->get_pv_coordinates();
+    EXPECT_LT(arma::norm(pv.get_position() - expected.subvec(0, 2)), 10.0);
+    EXPECT_LT(arma::norm(pv.get_velocity() - expected.subvec(3, 5)), 1e-2);
+  }
+}
+
+TEST(TestRegularizedPropagator, PlugsIntoPhysicalSystem)
+{
+  const vector_type state = get_circular_orbit({7000000.0, 0.0, 0.0});
+  const spacecraft sc("leo", state, 100.0);
+  physical_system<regularized_propagator<rk_dopri5_stepper>> system(sc, std::make_shared<point_mass_eoms>());
+
+  EXPECT_DOUBLE_EQ(system.simulate_to(600.0), 600.0);
+  const pv_state_type expected = kepler_propagate(state.subvec(0, 2), state.subvec(3, 5), 600.0);
+  const auto pos = system.get_spacecraft("leo")->get_pv_coordinates().get_position();
+  EXPECT_LT(arma::norm(pos - expected.subvec(0, 2)), 100.0);
+}
@@ -0,0 +1,55 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "orbits/orbits.h"
+#include "propagators/unscented_propagator.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+TEST(TestUnscentedPropagator, InitialEstimateMatchesInput)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms =
+      std::make_shared<two_body_force_model_eoms>(earth_body);
+  const vector_type state_vec = get_circular_orbit({6878000.0, 0.0, 0.0});
+  const auto sc = std::make_shared<spacecraft>("test", state_vec, 100.0);
+
+  arma::mat66 covariance = arma::diagmat(arma::vec6({100, 100, 100, 0.01, 0.01, 0.01}));
+  unscented_covariance_propagator<rk_dopri5_stepper> ukf(sc, covariance, eoms);
+
+  EXPECT_EQ(ukf.get_sigma_points().size(), 13);
+  const auto estimate = ukf.get_estimate();
+  EXPECT_TRUE(arma::approx_equal(estimate.mean, arma::vec6(state_vec), "absdiff", 1e-6));
+  EXPECT_TRUE(arma::approx_equal(estimate.covariance, covariance, "absdiff", 1e-6));
+}
+
+TEST(TestUnscentedPropagator, PropagatedCovarianceGrowsAlongTrack)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms =
+      std::make_shared<two_body_force_model_eoms>(earth_body);
+  const vector_type state_vec = get_circular_orbit({6878000.0, 0.0, 0.0});
+  const auto sc = std::make_shared<spacecraft>("test", state_vec, 100.0);
+
+  arma::mat66 covariance = arma::diagmat(arma::vec6({100, 100, 100, 0.01, 0.01, 0.01}));
+  unscented_covariance_propagator<rk_dopri5_stepper> ukf(sc, covariance, eoms);
+  const auto estimates = ukf.propagate({60.0, 600.0});
+
+  ASSERT_EQ(estimates.size(), 2);
+  const auto& final_estimate = estimates.back();
+  EXPECT_DOUBLE_EQ(final_estimate.t, 600.0);
+  EXPECT_TRUE(final_estimate.covariance.is_symmetric(1e-6));
+  EXPECT_GT(arma::trace(final_estimate.covariance.submat(0, 0, 2, 2)),
+            arma::trace(covariance.submat(0, 0, 2, 2)));
+}
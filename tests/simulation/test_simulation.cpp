@@ -17,3 +17,66 @@ using namespace naomi::bodies;
 using namespace naomi::forces;
 
 typedef std::shared_ptr<attitude_provider> att_provider_ptr;
+
+namespace
+{
+/**
+ * Stand-in for a physical system that only records where it was stopped.
+ */
+struct recording_system
+{
+  double t = 0;
+  std::vector<double> stops;
+
+  [[nodiscard]] double get_current_time() const
+  {
+    return t;
+  }
+
+  double simulate_to(const double end_time)
+  {
+    stops.push_back(end_time);
+    t = end_time;
+    return t;
+  }
+};
+
+class recording_observer final : public simulation_observer<recording_system>
+{
+public:
+  std::vector<double> times;
+
+  explicit recording_observer(const double obs_interval)
+      : simulation_observer(obs_interval)
+  {
+  }
+
+  void handle_observe_state(const std::shared_ptr<recording_system>& system) override
+  {
+    times.push_back(system->get_current_time());
+  }
+};
+}
+
+TEST(TestSimulation, SchedulesEveryObserver)
+{
+  const auto system = std::make_shared<recording_system>();
+  const auto telemetry = std::make_shared<recording_observer>(1.0);
+  const auto archive = std::make_shared<recording_observer>(4.0);
+  simulation<recording_system> sim(system, {telemetry, archive});
+  sim.simulate(10.0);
+
+  EXPECT_EQ(telemetry->times, std::vector<double>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+  EXPECT_EQ(archive->times, std::vector<double>({0, 4, 8}));
+  // The archive shares the stops of the telemetry
+  EXPECT_EQ(system->stops, std::vector<double>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST(TestSimulation, RunsToEndWithoutObservers)
+{
+  const auto system = std::make_shared<recording_system>();
+  simulation<recording_system> sim(system);
+  sim.simulate(10.0);
+
+  EXPECT_EQ(system->stops, std::vector<double>({10}));
+}
@@ -0,0 +1,51 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "simulation/tracing.h"
+
+using namespace naomi::tracing;
+
+TEST(TestTracing, WritesChromeTraceOfEveryThread)
+{
+  tracer& t = tracer::instance();
+  t.clear();
+  t.set_enabled(true);
+  {
+    const scoped_trace outer("outer");
+    const scoped_trace inner("propagate_to", "sc \"1\"");
+  }
+  std::thread worker([]
+  {
+    const scoped_trace scope("worker");
+  });
+  worker.join();
+  t.set_enabled(false);
+  {
+    const scoped_trace ignored("ignored");
+  }
+  EXPECT_EQ(t.size(), 3);
+
+  const std::string path = (std::filesystem::temp_directory_path() / "naomi_test_trace.json").string();
+  t.write_chrome_trace(path);
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string json = buffer.str();
+
+  EXPECT_EQ(json.rfind(R"({"displayTimeUnit": "ms", "traceEvents": [)", 0), 0);
+  EXPECT_NE(json.find(R"("name": "outer")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name": "worker")"), std::string::npos);
+  EXPECT_NE(json.find(R"("args": {"detail": "sc \"1\""})"), std::string::npos);
+  EXPECT_EQ(json.find("ignored"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph": "X")"), std::string::npos);
+  std::filesystem::remove(path);
+  t.clear();
+}
@@ -0,0 +1,100 @@
+//
+// Created by alex on 10/19/2026.
+//
+
+#include <set>
+
+#include <armadillo>
+
+#include <gtest/gtest.h>
+
+#include "bodies/earth.h"
+#include "forces/two_body_force_model.h"
+#include "constants.h"
+#include "orbits/orbits.h"
+#include "propagators/numerical_propagator.h"
+#include "systems/system.h"
+#include "systems/walker_constellation.h"
+
+using namespace naomi;
+using namespace naomi::bodies;
+using namespace naomi::forces;
+using namespace naomi::numeric;
+using namespace naomi::orbits;
+
+namespace
+{
+constexpr double sma = 7000000.0;
+const double inc = 53.0 * arma::datum::pi / 180.0;
+}
+
+TEST(TestWalkerConstellation, DeltaPatternElements)
+{
+  const walker_constellation walker(walker_pattern::DELTA, sma, inc, 24, 3, 1);
+  const keplerian_batch elements = walker.get_elements();
+  ASSERT_EQ(elements.size(), 24u);
+  EXPECT_NEAR(elements.raan[0], 0.0, 1e-15);
+  EXPECT_NEAR(elements.raan[8], 2 * arma::datum::pi / 3, 1e-15);
+  EXPECT_NEAR(elements.raan[16], 4 * arma::datum::pi / 3, 1e-15);
+  EXPECT_NEAR(elements.ma[1], 2 * arma::datum::pi / 8, 1e-15);
+  // Neighbouring planes are shifted by f * 360 deg / t
+  EXPECT_NEAR(elements.ma[8], 2 * arma::datum::pi / 24, 1e-15);
+  EXPECT_NEAR(elements.ma[16], 4 * arma::datum::pi / 24, 1e-15);
+}
+
+TEST(TestWalkerConstellation, StarPatternSpreadsOverHalfCircle)
+{
+  const walker_constellation walker(walker_pattern::STAR, sma, arma::datum::pi / 2, 66, 6, 2);
+  const keplerian_batch elements = walker.get_elements();
+  EXPECT_NEAR(elements.raan[65], 5 * arma::datum::pi / 6, 1e-15);
+}
+
+TEST(TestWalkerConstellation, StatesAreCircular)
+{
+  const walker_constellation walker(walker_pattern::DELTA, sma, inc, 1200, 30, 7);
+  const cartesian_batch states = walker.get_states();
+  const double speed = std::sqrt(constants::EARTH_MU / sma);
+  for (std::size_t i = 0; i < states.size(); i++) {
+    const arma::vec3 r = {states.x[i], states.y[i], states.z[i]};
+    const arma::vec3 v = {states.vx[i], states.vy[i], states.vz[i]};
+    EXPECT_NEAR(arma::norm(r), sma, 1e-6);
+    EXPECT_NEAR(arma::norm(v), speed, 1e-9);
+    EXPECT_NEAR(std::acos(arma::normalise(arma::cross(r, v))(2)), inc, 1e-12);
+  }
+}
+
+TEST(TestWalkerConstellation, RejectsInvalidPatterns)
+{
+  EXPECT_THROW(walker_constellation(walker_pattern::DELTA, sma, inc, 10, 3, 1), std::runtime_error);
+  EXPECT_THROW(walker_constellation(walker_pattern::DELTA, sma, inc, 12, 3, 3), std::runtime_error);
+  EXPECT_THROW(walker_constellation(walker_pattern::DELTA, sma, inc, 12, 0, 0), std::runtime_error);
+}
+
+TEST(TestWalkerConstellation, SystemStoresGeneratedSpacecraft)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  const walker_constellation walker(walker_pattern::DELTA, sma, inc, 2000, 40, 3);
+  const auto spacecrafts = walker.make_spacecraft(100.0);
+
+  physical_system<numerical_propagator<rk_dopri5_stepper>> system(spacecrafts, eoms);
+  const auto stored = system.get_spacecrafts();
+  ASSERT_EQ(stored.size(), 2000u);
+  // The system holds the generated objects, not copies
+  EXPECT_EQ(system.get_spacecraft("sat-0-0").get(), spacecrafts.front().get());
+  EXPECT_EQ(system.get_spacecraft("sat-39-49").get(), spacecrafts.back().get());
+}
+
+TEST(TestWalkerConstellation, SystemFromVectorOfSpacecraft)
+{
+  const std::shared_ptr<celestial_body> earth_body = std::make_shared<earth>();
+  const std::shared_ptr<equations_of_motion> eoms = std::make_shared<two_body_force_model_eoms>(earth_body);
+  std::vector<spacecraft> spacecrafts;
+  spacecrafts.emplace_back("a", get_circular_orbit({7000000.0, 0.0, 0.0}), 100.0);
+  spacecrafts.emplace_back("b", get_circular_orbit({0.0, 8000000.0, 0.0}), 100.0);
+
+  physical_system<numerical_propagator<rk_dopri5_stepper>> system(std::move(spacecrafts), eoms);
+  ASSERT_EQ(system.get_spacecrafts().size(), 2u);
+  EXPECT_EQ(system.get_spacecraft("b")->get_identifier(), "b");
+  EXPECT_DOUBLE_EQ(system.simulate_to(100.0), 100.0);
+}